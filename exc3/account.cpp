@@ -4,36 +4,42 @@
 */
 
 #include "account.h"
-#include <iostream>
+#include "eventlog.h"
 
 // Constructor
 Account::Account() {
-  balance_ = 0.0;
+  balance_ = Money();
+}
+
+// Constructor with initial balance
+Account::Account(Money balance) {
+  balance_ = balance;
 }
 
 // Destructor
 Account::~Account() {
-  std::cout << "Account closed." << std::endl;
+  event_log().log(LOG_INFO, EVENT_ACCOUNT_CLOSED);
 }
 
 // Getter
-double Account::balance() {
+Money Account::balance() {
   return balance_;
 }
 
 // Setter
-void Account::deposit(double euro) {
+bool Account::deposit(Money euro) {
   if (euro > 0.0) {
     balance_ += euro;
+    return true;
   } else {
-    std::cout << "Operation invalid: Please enter an amount greater than nothing." << std::endl;
+    event_log().log(LOG_WARNING, EVENT_INVALID_DEPOSIT, 0, 0, euro);
+    return false;
   }
 }
 
-bool Account::withdraw(double euro) {
+bool Account::withdraw(Money euro) {
   if (euro < 0.0) {
-    std::cout << "Operation invalid: We appreciate your donation very much, " 
-    << "unfortunately we are not allowed to accept it in this way." << std::endl;
+    event_log().log(LOG_WARNING, EVENT_INVALID_WITHDRAW, 0, 0, euro);
     return false;
   }
   if (balance_ >= euro) {
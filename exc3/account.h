@@ -4,19 +4,22 @@
 */
 #pragma once
 
+#include "money.h"
+
 class Account
 {
   public:
-  Account();  // Constructor
-  ~Account(); // Dectructor
+  Account();              // Constructor
+  Account(Money balance); // Constructor with initial balance
+  virtual ~Account();     // Dectructor
   
   // Getter
-  double balance();
+  Money balance();
   
   // Setter
-  void deposit(double euro);
-  bool withdraw(double euro);
+  bool deposit(Money euro);
+  virtual bool withdraw(Money euro);
   
   protected:
-  double balance_;
+  Money balance_;
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// flat account index
+// * open addressing with linear probing in one contiguous slot array
+// * the value is stored inline next to the account number,
+//   so a lookup usually touches a single cache line
+// * the capacity is a power of two and the load factor is kept below 3/4
+template <class T>
+class AccountIndex
+{
+public:
+
+    AccountIndex(unsigned int capacity = 16)
+        : size_(0) {
+        unsigned int n = 16;
+        while (n < capacity) n *= 2;
+        slots_.resize(n);
+    }
+
+    ~AccountIndex() {}
+
+    // return the value stored for the account number
+    // * or NULL if the account number is not existing
+    T *find(int key) {
+        unsigned int mask = slots_.size()-1;
+
+        for (unsigned int i = home(key);; i = (i+1)&mask) {
+            Slot &slot = slots_[i];
+            if (!slot.used) return NULL;
+            if (slot.key == key) return &slot.value;
+        }
+    }
+
+    // insert a value for an account number
+    // * returns the stored value and true if the account number was not already taken
+    // * otherwise returns the existing value and false
+    pair<T*, bool> insert(int key, const T &value) {
+        if (4*(size_+1) > 3*slots_.size()) grow();
+
+        unsigned int mask = slots_.size()-1;
+
+        for (unsigned int i = home(key);; i = (i+1)&mask) {
+            Slot &slot = slots_[i];
+            if (!slot.used) {
+                slot.key = key;
+                slot.used = true;
+                slot.value = value;
+                size_++;
+                return pair<T*, bool>(&slot.value, true);
+            }
+            if (slot.key == key) return pair<T*, bool>(&slot.value, false);
+        }
+    }
+
+    // call f(key, value) for all stored accounts
+    template <class F>
+    void for_each(F f) {
+        for (unsigned int i = 0; i < slots_.size(); i++)
+            if (slots_[i].used) f(slots_[i].key, slots_[i].value);
+    }
+
+    // return the number of stored accounts
+    unsigned int size() const {
+        return size_;
+    }
+
+protected:
+
+    struct Slot {
+        Slot() : key(0), used(false) {}
+
+        int key;
+        bool used;
+        T value;
+    };
+
+    // fibonacci hashing of the account number onto the slot array
+    unsigned int home(int key) const {
+        return (unsigned int)(((unsigned long long)(unsigned int)key * 0x9E3779B97F4A7C15ull) >> 32) & (slots_.size()-1);
+    }
+
+    // double the capacity and reinsert all accounts
+    void grow() {
+        vector<Slot> slots(2*slots_.size());
+        slots_.swap(slots);
+        size_ = 0;
+
+        for (unsigned int i = 0; i < slots.size(); i++)
+            if (slots[i].used) insert(slots[i].key, slots[i].value);
+    }
+
+    vector<Slot> slots_;
+    unsigned int size_;
+};
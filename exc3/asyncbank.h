@@ -0,0 +1,283 @@
+#pragma once
+
+#include "bank.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// queued bank operation
+struct AsyncTask
+{
+    AsyncTask() : next(NULL) {}
+
+    function<void()> run;
+    atomic<AsyncTask *> next;
+};
+
+// multiple-producer single-consumer queue of bank operations
+// * producers link their task in with a single atomic exchange and never block
+// * only the owning worker pops, in the order the tasks were linked in
+class AsyncQueue
+{
+public:
+
+    AsyncQueue()
+        : head_(&stub_), tail_(&stub_) {}
+
+    // delete the tasks that were never run
+    ~AsyncQueue() {
+        AsyncTask *task;
+        while ((task = pop()) != NULL) delete task;
+    }
+
+    // append a task
+    // * may be called from any thread
+    void push(AsyncTask *task) {
+        task->next.store(NULL, memory_order_relaxed);
+        AsyncTask *prev = head_.exchange(task);
+        prev->next.store(task, memory_order_release);
+    }
+
+    // remove the oldest task
+    // * only called from the consumer
+    // * returns NULL if the queue is empty or a push is still in progress
+    AsyncTask *pop() {
+        AsyncTask *tail = tail_;
+        AsyncTask *next = tail->next.load(memory_order_acquire);
+
+        if (tail == &stub_) {
+            if (next == NULL) return NULL;
+            tail_ = tail = next;
+            next = next->next.load(memory_order_acquire);
+        }
+
+        if (next != NULL) {
+            tail_ = next;
+            return tail;
+        }
+
+        if (tail != head_.load()) return NULL;
+
+        // the last task is only handed out with the stub behind it
+        push(&stub_);
+
+        next = tail->next.load(memory_order_acquire);
+        if (next != NULL) {
+            tail_ = next;
+            return tail;
+        }
+
+        return NULL;
+    }
+
+    // return true if no task was pushed since the last pop
+    // * only called from the consumer
+    bool empty() const {
+        return tail_ == &stub_ && head_.load() == &stub_;
+    }
+
+protected:
+
+    AsyncTask stub_;
+    atomic<AsyncTask *> head_; // last pushed task
+    AsyncTask *tail_;          // next task to pop
+};
+
+// worker of the asynchronous bank
+struct AsyncWorker
+{
+    AsyncWorker() : sleeping(false) {}
+
+    AsyncQueue queue;
+
+    mutex lock;
+    condition_variable wake;
+    atomic<bool> sleeping;
+
+    thread worker;
+};
+
+// asynchronous front-end of a bank
+// * operations are submitted without blocking and complete a future or call a callback
+// * each account is served by one worker, so the operations of an account run in submission order
+// * transfers are ordered with the operations of the source account
+// * passwords are copied into the queued operation, so the caller's string may go away
+// * with more than one worker the bank must be thread-safe (e.g. ShardedBank),
+//   so operations on accounts of different workers proceed in parallel
+class AsyncBank
+{
+public:
+
+    AsyncBank(Bank *bank, unsigned int workers = 4)
+        : bank_(bank), workers_(workers>0?workers:1), stop_(false) {
+        for (unsigned int i = 0; i < workers_.size(); i++)
+            workers_[i].worker = thread(&AsyncBank::work, this, &workers_[i]);
+    }
+
+    // run all submitted operations and stop the workers
+    ~AsyncBank() {
+        stop_ = true;
+
+        for (unsigned int i = 0; i < workers_.size(); i++) {
+            {
+                lock_guard<mutex> guard(workers_[i].lock);
+                workers_[i].wake.notify_one();
+            }
+            workers_[i].worker.join();
+        }
+    }
+
+    // deposit amount on account
+    // * the future yields true if the deposit was successful
+    future<bool> deposit(int account_nr, Money amount) {
+        Bank *bank = bank_;
+        return submit<bool>(account_nr, [bank, account_nr, amount]() {
+            return bank->deposit(account_nr, amount);
+        });
+    }
+
+    // withdraw amount from account
+    // * the future yields true if the withdrawal was successful
+    future<bool> withdraw(int account_nr, string_view passwd, Money amount) {
+        Bank *bank = bank_;
+        return submit<bool>(account_nr, [bank, account_nr, passwd = string(passwd), amount]() {
+            return bank->withdraw(account_nr, passwd, amount);
+        });
+    }
+
+    // transfer amount from one account to another one
+    // * the future yields true if the transfer was successful
+    future<bool> transfer(int from, int to, string_view passwd, Money amount) {
+        Bank *bank = bank_;
+        return submit<bool>(from, [bank, from, to, passwd = string(passwd), amount]() {
+            return bank->transfer(from, to, passwd, amount);
+        });
+    }
+
+    // return the account balance
+    // * the future yields the balance or 0 if the account or passwd is wrong
+    future<Money> balance(int account_nr, string_view passwd) {
+        Bank *bank = bank_;
+        return submit<Money>(account_nr, [bank, account_nr, passwd = string(passwd)]() {
+            return bank->balance(account_nr, passwd);
+        });
+    }
+
+    // deposit amount on account
+    // * "done" is called on the worker with the result
+    void deposit(int account_nr, Money amount, function<void(bool)> done) {
+        Bank *bank = bank_;
+        submit(account_nr, [bank, account_nr, amount, done]() {
+            done(bank->deposit(account_nr, amount));
+        });
+    }
+
+    // withdraw amount from account
+    // * "done" is called on the worker with the result
+    void withdraw(int account_nr, string_view passwd, Money amount, function<void(bool)> done) {
+        Bank *bank = bank_;
+        submit(account_nr, [bank, account_nr, passwd = string(passwd), amount, done]() {
+            done(bank->withdraw(account_nr, passwd, amount));
+        });
+    }
+
+    // transfer amount from one account to another one
+    // * "done" is called on the worker with the result
+    void transfer(int from, int to, string_view passwd, Money amount, function<void(bool)> done) {
+        Bank *bank = bank_;
+        submit(from, [bank, from, to, passwd = string(passwd), amount, done]() {
+            done(bank->transfer(from, to, passwd, amount));
+        });
+    }
+
+    // return the account balance
+    // * "done" is called on the worker with the balance
+    void balance(int account_nr, string_view passwd, function<void(Money)> done) {
+        Bank *bank = bank_;
+        submit(account_nr, [bank, account_nr, passwd = string(passwd), done]() {
+            done(bank->balance(account_nr, passwd));
+        });
+    }
+
+    // return the number of workers
+    unsigned int workers() const {
+        return workers_.size();
+    }
+
+protected:
+
+    // same distribution as the shards of ShardedBank
+    unsigned int worker_index(int account_nr) const {
+        return ((unsigned int)account_nr*2654435761u) % workers_.size();
+    }
+
+    // queue a task on the worker of an account
+    void submit(int account_nr, function<void()> run) {
+        AsyncWorker &worker = workers_[worker_index(account_nr)];
+
+        AsyncTask *task = new AsyncTask;
+        task->run = move(run);
+
+        worker.queue.push(task);
+
+        // only take the lock if the worker went to sleep
+        if (worker.sleeping.load()) {
+            lock_guard<mutex> guard(worker.lock);
+            worker.wake.notify_one();
+        }
+    }
+
+    // queue a task and return the future of its result
+    template <class R, class F>
+    future<R> submit(int account_nr, F f) {
+        shared_ptr<promise<R> > result = make_shared<promise<R> >();
+        future<R> value = result->get_future();
+
+        submit(account_nr, [result, f]() {
+            result->set_value(f());
+        });
+
+        return value;
+    }
+
+    // worker loop
+    // * runs the tasks of its queue until the bank is stopped and the queue is empty
+    void work(AsyncWorker *worker) {
+        for (;;) {
+            AsyncTask *task = worker->queue.pop();
+
+            if (task != NULL) {
+                task->run();
+                delete task;
+                continue;
+            }
+
+            unique_lock<mutex> guard(worker->lock);
+
+            worker->sleeping.store(true);
+
+            if (worker->queue.empty()) {
+                if (stop_) break;
+                worker->wake.wait_for(guard, chrono::milliseconds(1));
+            }
+
+            worker->sleeping.store(false);
+        }
+    }
+
+    Bank *bank_;
+
+    vector<AsyncWorker> workers_;
+    atomic<bool> stop_;
+};
@@ -1,9 +1,35 @@
 #pragma once
 
 #include "account.h"
+#include "money.h"
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// transfer record of a transfer batch
+struct TransferRecord
+{
+   int from;
+   int to;
+   std::string passwd;
+   Money amount;
+};
+
+// result of a transaction commit
+enum TransactionResult
+{
+   TX_COMMITTED = 0,  // all writes applied
+   TX_CONFLICT = 1,   // an account read by the transaction was changed, retry
+   TX_INVALID = 2,    // an account does not exist or an amount is not positive
+   TX_DENIED = 3,     // wrong password of a withdrawal
+   TX_DECLINED = 4,   // a withdrawal exceeds the balance or giro limit
+   TX_ABORTED = 5,    // aborted by the caller
+   TX_UNSUPPORTED = 6 // the bank does not support transactions
+};
+
+class Transaction;
 
 // bank interface
 class Bank
@@ -17,29 +43,53 @@ public:
    // * with account number "account",
    // * password "passwd"
    // * and a reference "a" to a new account
-   virtual bool open_account(int account, std::string passwd, Account *a) = 0;
+   // * on success the bank owns the account, otherwise it is left to the caller
+   virtual bool open_account(int account, std::string_view passwd, Account *a) = 0;
 
    // deposit amount on account
    // * if account is existing
-   virtual void deposit(int account, double amount) = 0;
+   // * returns true if the deposit was successful
+   virtual bool deposit(int account, Money amount) = 0;
 
    // withdraw amount from account
    // * if account is existing
    // * and if passwd matches the account password
-   virtual bool withdraw(int account, std::string passwd, double amount) = 0;
+   virtual bool withdraw(int account, std::string_view passwd, Money amount) = 0;
 
    // transfer amount from one account to another one
    // * if both accounts are existing
    // * and if passwd matches the account password
    // * and if the withdrawal was successful
-   virtual bool transfer(int from, int to, std::string passwd, double amount) = 0;
+   virtual bool transfer(int from, int to, std::string_view passwd, Money amount) = 0;
+
+   // transfer a batch of "count" records
+   // * each record is handled like a single transfer in the given order
+   // * returns the result of each transfer
+   virtual std::vector<bool> transfer_batch(const TransferRecord *records, unsigned int count)
+   {
+      std::vector<bool> results(count);
+      for (unsigned int i=0; i<count; i++)
+         results[i] = transfer(records[i].from, records[i].to, records[i].passwd, records[i].amount);
+      return results;
+   }
 
    // return the account balance
    // * if account is existing
    // * and if passwd matches the account password
-   virtual double balance(int account, std::string passwd) = 0;
+   virtual Money balance(int account, std::string_view passwd) = 0;
 
    // return the total bank balance
    // * which is the sum of all account balances
-   double total_balance() { return 0; }
+   virtual Money total_balance() { return Money(); }
+
+   // read the balance and the version of an account for a transaction
+   // * if account is existing
+   // * and if passwd matches the account password
+   // * the version changes with every change of the account balance
+   virtual bool read_version(int account, std::string_view passwd, Money *balance, unsigned long long *version) { return false; }
+
+   // validate and apply a transaction atomically
+   // * fails with TX_CONFLICT if an account read by the transaction has changed since
+   // * either all writes are applied or none
+   virtual TransactionResult commit(const Transaction &tx) { return TX_UNSUPPORTED; }
 };
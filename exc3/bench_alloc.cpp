@@ -0,0 +1,99 @@
+#include "cccbank.h"
+#include "poolbank.h"
+#include "shardedbank.h"
+
+#include "checking.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <stdlib.h>
+
+// count all heap allocations of the process
+// * not inlined, otherwise gcc reports malloc and free as mismatched with new and delete
+static atomic<unsigned long long> allocations(0);
+
+__attribute__((noinline)) void *operator new(size_t size)
+{
+    allocations++;
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+// a password longer than the small string buffer of std::string
+static const char *passwd = "correct horse battery staple";
+
+// transfer between "sessions" accounts in turn
+// * with up to 16 sessions the verified credentials stay in the per-thread cache
+// * returns the nanoseconds per transfer and the allocations per transfer
+template <class B>
+void run(B &bank, int sessions, int transfers, double *ns, double *allocs)
+{
+    unsigned long long before = allocations;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int n=0; n<transfers; n++)
+        bank.transfer(n%sessions+1, (n+1)%sessions+1, passwd, 1);
+
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now()-start;
+
+    *ns = elapsed.count()/transfers;
+    *allocs = (double)(allocations-before)/transfers;
+}
+
+template <class B>
+void report(const char *name, int accounts, int transfers)
+{
+    B bank(accounts);
+
+    for (int i=1; i<=accounts; i++)
+        bank.open_account(i, passwd, new CheckingAccount(100, 1000));
+
+    double cached_ns, cached_allocs, cold_ns, cold_allocs;
+
+    run(bank, 16, transfers, &cached_ns, &cached_allocs);
+    run(bank, accounts, transfers, &cold_ns, &cold_allocs);
+
+    cout << name << ": cached " << cached_ns << " ns/transfer, " << cached_allocs << " allocations/transfer"
+         << "; uncached " << cold_ns << " ns/transfer, " << cold_allocs << " allocations/transfer" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int accounts = 1000;
+    int transfers = 1000000;
+
+    if (argc > 1) accounts = atoi(argv[1]);
+    if (argc > 2) transfers = atoi(argv[2]);
+
+    // silence the event log of the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    report<CCCBank>("CCCBank", accounts, transfers);
+    report<ShardedBank>("ShardedBank", accounts, transfers);
+    report<PoolBank>("PoolBank", accounts, transfers);
+
+    // a std::string parameter taken by value as before
+    unsigned long long before = allocations;
+    for (int n=0; n<transfers; n++) {
+        string copy(passwd);
+        if (copy.empty()) break;
+    }
+    cout << "std::string copy of the password: " << (double)(allocations-before)/transfers << " allocations/call" << endl;
+
+    return(0);
+}
@@ -0,0 +1,99 @@
+#include "asyncbank.h"
+#include "shardedbank.h"
+
+#include "checking.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+// front-end threads issue transfers between the accounts of their own block
+// * either synchronously on the bank or through the asynchronous queue
+// * each account holds enough money for all of its transfers,
+//   so every transfer succeeds in whatever order the workers run them
+//   and the synchronous and the asynchronous run end with the same balances
+// * returns the transfers per second seen by the front-end threads,
+//   the final balances and the number of successful transfers
+double run(int threads, int transfers, int workers, double *completed, vector<Money> *balances, int *successful_transfers)
+{
+    ShardedBank bank;
+
+    for (int i=1; i<=100*threads; i++) {
+        bank.open_account(i, "", new CheckingAccount(i));
+        bank.deposit(i, Money(100*(transfers/100+1)));
+    }
+
+    atomic<int> successful(0);
+    vector<thread> frontends;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::duration<double> submitted;
+
+    {
+        AsyncBank *async = workers > 0 ? new AsyncBank(&bank, workers) : NULL;
+
+        for (int t=0; t<threads; t++)
+            frontends.push_back(thread([&bank, async, &successful, t, transfers]() {
+                int base = 100*t;
+                for (int n=0; n<transfers; n++) {
+                    int from = base+(271*n+71)%100+1;
+                    int to = base+n%100+1;
+                    if (async) async->transfer(from, to, "", n%100+1, [&successful](bool ok) { successful += ok; });
+                    else successful += bank.transfer(from, to, "", n%100+1);
+                }
+            }));
+
+        for (int t=0; t<threads; t++)
+            frontends[t].join();
+
+        submitted = chrono::steady_clock::now()-start;
+
+        // wait for the queued transfers
+        delete async;
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    *completed = 1.0*threads*transfers/elapsed.count();
+    *successful_transfers = successful;
+
+    balances->clear();
+    for (int i=1; i<=100*threads; i++)
+        balances->push_back(bank.balance(i, ""));
+
+    return 1.0*threads*transfers/submitted.count();
+}
+
+int main(int argc, char *argv[])
+{
+    int threads = 4;
+    int workers = 4;
+    int transfers = 200000;
+
+    if (argc > 1) threads = atoi(argv[1]);
+    if (argc > 2) workers = atoi(argv[2]);
+    if (argc > 3) transfers = atoi(argv[3]);
+
+    // silence the event log of the accounts
+    event_log().set_level(LOG_OFF);
+
+    double completed1, completed2;
+    vector<Money> balances1, balances2;
+    int successful1, successful2;
+
+    double submit1 = run(threads, transfers, 0, &completed1, &balances1, &successful1);
+    double submit2 = run(threads, transfers, workers, &completed2, &balances2, &successful2);
+
+    cout << "front-end threads: " << threads << ", workers: " << workers << endl;
+    cout << "synchronous: " << submit1 << " transfers/s" << endl;
+    cout << "asynchronous: " << submit2 << " submits/s, " << completed2 << " completed transfers/s" << endl;
+    cout << "caller speedup: " << submit2/submit1
+         << (balances1 == balances2 ? "" : " (account balance mismatch)")
+         << (successful1 == successful2 ? "" : " (completed transfer mismatch)") << endl;
+
+    return(0);
+}
@@ -0,0 +1,142 @@
+#include "shardedbank.h"
+#include "transaction.h"
+
+#include "checking.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+// deposit on one merchant account from a number of threads
+// * a withdrawing thread reads the account at the same time
+// * returns the deposits per second
+double run(int threads, int deposits, bool hot, bool *balanced)
+{
+    ShardedBank bank;
+
+    bank.open_account(1, "", new CheckingAccount(1000));
+    if (hot) bank.mark_hot(1);
+
+    vector<thread> workers;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int t=0; t<threads; t++)
+        workers.push_back(thread([&bank, deposits]() {
+            for (int n=0; n<deposits; n++) bank.deposit(1, 1);
+        }));
+
+    // withdraw 1 euro now and then, the credits must be folded before each check
+    int withdrawn = 0;
+    for (int n=0; n<100; n++)
+        withdrawn += bank.withdraw(1, "", 1);
+
+    for (int t=0; t<threads; t++)
+        workers[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    Money expected = Money(1.0*threads*deposits-withdrawn);
+    *balanced = (bank.balance(1, "") == expected && bank.total_balance() == expected);
+
+    return 1.0*threads*deposits/elapsed.count();
+}
+
+// run transactions on the merchant account while other threads deposit on it
+// * each transaction reads the account, withdraws 1 euro and deposits it on a second account
+// * the threads deposit until all transactions are committed
+// * lock-free deposits must not make the transactions conflict
+// * returns the retries per transaction
+double run_tx(int threads, int transactions, bool *balanced)
+{
+    ShardedBank bank;
+
+    bank.open_account(1, "", new CheckingAccount(1.0*transactions));
+    bank.open_account(2, "", new Account());
+    bank.mark_hot(1);
+
+    atomic<bool> done(false);
+    atomic<long long> deposits(0);
+    vector<thread> workers;
+
+    for (int t=0; t<threads; t++)
+        workers.push_back(thread([&bank, &done, &deposits]() {
+            while (!done) deposits += bank.deposit(1, 1);
+        }));
+
+    long long attempts = 0, committed = 0;
+
+    for (int n=0; n<transactions; n++) {
+        TransactionResult result = run_transaction(&bank, [&](Transaction &tx) {
+            attempts++;
+
+            Money balance;
+            if (!tx.read(1, "", &balance)) return false;
+
+            // let the depositors credit between the read and the commit
+            this_thread::yield();
+
+            tx.transfer(1, 2, "", 1);
+
+            return true;
+        });
+
+        if (result == TX_COMMITTED) committed++;
+    }
+
+    done = true;
+
+    for (int t=0; t<threads; t++)
+        workers[t].join();
+
+    Money expected = Money(1.0*deposits-committed);
+    *balanced = (committed == transactions &&
+                 bank.balance(1, "") == expected && bank.balance(2, "") == Money(1.0*committed) &&
+                 bank.total_balance() == Money(1.0*deposits));
+
+    return (double)(attempts-committed)/transactions;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_threads = 64;
+    int deposits = 200000;
+
+    if (argc > 1) max_threads = atoi(argv[1]);
+    if (argc > 2) deposits = atoi(argv[2]);
+    if (max_threads < 1) max_threads = 1;
+
+    // silence the event log of the accounts
+    event_log().set_level(LOG_OFF);
+
+    for (int threads=1; ; threads=min(2*threads, max_threads))
+    {
+        bool balanced1, balanced2;
+
+        double ops1 = run(threads, deposits, false, &balanced1);
+        double ops2 = run(threads, deposits, true, &balanced2);
+
+        cerr << "threads: " << threads
+             << ", locked: " << ops1 << " deposits/s"
+             << ", hot: " << ops2 << " deposits/s"
+             << ", speedup: " << ops2/ops1
+             << (balanced1 && balanced2 ? "" : " (balance mismatch)") << endl;
+
+        bool balanced3;
+
+        double retries = run_tx(threads, 10000, &balanced3);
+
+        cerr << "threads: " << threads
+             << ", transactions on hot account: " << retries << " retries/commit"
+             << (balanced3 ? "" : " (balance mismatch)") << endl;
+
+        if (threads == max_threads) break;
+    }
+
+    return(0);
+}
@@ -0,0 +1,91 @@
+#include "cccbank.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <stdlib.h>
+
+// pseudo-random account numbers
+unsigned int next_random(unsigned int *state)
+{
+    *state = *state*1664525u+1013904223u;
+    return *state;
+}
+
+// look up accounts in random order and authenticate them
+// * returns the nanoseconds per lookup
+template <class L>
+double measure(L lookup, const vector<int> &keys, int lookups)
+{
+    unsigned int state = 4711;
+    int found = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int i=0; i<lookups; i++)
+        found += lookup(keys[next_random(&state)%keys.size()]);
+
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now()-start;
+
+    if (found != lookups) cerr << "lookup mismatch" << endl;
+
+    return elapsed.count()/lookups;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_exponent = 7;
+    int lookups = 10000000;
+
+    if (argc > 1) max_exponent = atoi(argv[1]);
+    if (argc > 2) lookups = atoi(argv[2]);
+
+    Account account;
+    PasswordDigest digest = PasswordDigest::of(0, "secret");
+
+    for (int e=3, n=1000; e<=max_exponent; e++, n*=10)
+    {
+        vector<int> keys(n);
+        unsigned int state = 42;
+
+        for (int i=0; i<n; i++)
+            keys[i] = next_random(&state)&0x7fffffff;
+
+        double map_ns, index_ns;
+
+        // ordered map as used by the original CCC-Bank
+        {
+            map<int, ProtectedAccount> accounts;
+
+            for (int i=0; i<n; i++)
+                accounts.insert(pair<int, ProtectedAccount>(keys[i], ProtectedAccount(&account, digest)));
+
+            map_ns = measure([&accounts, &digest](int key) {
+                map<int, ProtectedAccount>::iterator it = accounts.find(key);
+                return it != accounts.end() && (it->second).digest.equals(digest);
+            }, keys, lookups);
+        }
+
+        // flat account index
+        {
+            AccountIndex<ProtectedAccount> accounts;
+
+            for (int i=0; i<n; i++)
+                accounts.insert(keys[i], ProtectedAccount(&account, digest));
+
+            index_ns = measure([&accounts, &digest](int key) {
+                ProtectedAccount *it = accounts.find(key);
+                return it != NULL && it->digest.equals(digest);
+            }, keys, lookups);
+        }
+
+        cout << "accounts: " << n
+             << ", map: " << map_ns << " ns/lookup"
+             << ", index: " << index_ns << " ns/lookup"
+             << ", speedup: " << map_ns/index_ns << endl;
+    }
+
+    return(0);
+}
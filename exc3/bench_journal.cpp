@@ -0,0 +1,112 @@
+#include "journal.h"
+#include "shardedbank.h"
+
+#include "checking.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// run the deposit and transfer pattern of main.cpp on a journaled bank
+// * the operations are split over a number of threads
+// * with waiting each operation waits for its record to be durable,
+//   so a group commit holds at most one record per thread
+// * without waiting the operations are acknowledged once appended,
+//   so the groups fill up to the group size and the run ends with a final sync
+// * returns the operations per second and the durable records per sync
+double run(const string &filename, unsigned int group, int threads, bool wait, int ops, Money *total, double *per_sync)
+{
+    remove(filename.c_str());
+
+    ShardedBank bank;
+    Journal journal(filename, group);
+    JournalBank journaled(&bank, &journal, wait);
+
+    if (!journal.good()) {
+        cerr << "unable to open journal " << filename << endl;
+        exit(1);
+    }
+
+    for (int i=1; i<=100; i++)
+        journaled.open_account(i, "", new CheckingAccount(i));
+
+    journal.sync();
+
+    unsigned long long records = journal.durable();
+    unsigned long long syncs = journal.syncs();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    vector<thread> workers;
+
+    for (int t=0; t<threads; t++)
+        workers.push_back(thread([&journaled, t, threads, ops]() {
+            for (int n=2*t; n<ops; n+=2*threads)
+            {
+                int i = n/2%100+1;
+                journaled.deposit((271*(i-1)+17)%100+1, i);
+                journaled.transfer((271*(i-1)+71)%100+1, i, "", i);
+            }
+        }));
+
+    for (int t=0; t<threads; t++)
+        workers[t].join();
+
+    if (!journal.sync()) {
+        cerr << "unable to sync journal " << filename << endl;
+        exit(1);
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    records = journal.durable()-records;
+    syncs = journal.syncs()-syncs;
+
+    *total = journaled.total_balance();
+    *per_sync = syncs > 0 ? (double)records/syncs : 0.0;
+
+    return ops/elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    string filename = "bench_journal.log";
+    int ops = 40000;
+
+    if (argc > 1) filename = argv[1];
+    if (argc > 2) ops = atoi(argv[2]);
+
+    // silence the event log of the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    unsigned int groups[] = {1, 64, 4096};
+    int threads[] = {1, 16, 64};
+
+    for (int g=0; g<3; g++)
+        for (int w=1; w>=0; w--)
+            for (int t=0; t<3; t++)
+            {
+                Money total;
+                double per_sync;
+                double rate = run(filename, groups[g], threads[t], w, ops, &total, &per_sync);
+
+                // recover the journal into a fresh bank
+                CCCBank recovered;
+                long long records = Journal::replay(filename, recovered);
+
+                cout << "group size: " << groups[g] << ", " << (w ? "waiting" : "not waiting")
+                     << ", threads: " << threads[t]
+                     << ", " << rate << " ops/s"
+                     << ", records per sync: " << per_sync
+                     << ", replayed records: " << records
+                     << (recovered.total_balance() == total ? "" : " (total balance mismatch)") << endl;
+            }
+
+    remove(filename.c_str());
+
+    return(0);
+}
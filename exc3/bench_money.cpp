@@ -0,0 +1,50 @@
+#include "poolbank.h"
+
+#include <chrono>
+#include <iostream>
+
+#include <stdlib.h>
+
+int main(int argc, char *argv[])
+{
+    int accounts = 10000000;
+    int rounds = 10;
+
+    if (argc > 1) accounts = atoi(argv[1]);
+    if (argc > 2) rounds = atoi(argv[2]);
+
+    PoolBank bank(accounts);
+
+    for (int i=1; i<=accounts; i++)
+        bank.open_account(i, "", i%2 ? POOL_CHECKING : POOL_ACCOUNT, 100, Money::from_cents(i%100000-10000));
+
+    Money before = bank.total_balance();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int r=0; r<rounds; r++)
+        if (!bank.post_interest(12500)) cerr << "interest overflow" << endl;
+
+    chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+
+    for (int r=0; r<rounds; r++)
+        if (!bank.post_fee(Money::from_cents(250))) cerr << "fee overflow" << endl;
+
+    chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+    double interest_ms = chrono::duration<double, milli>(middle-start).count()/rounds;
+    double fee_ms = chrono::duration<double, milli>(stop-middle).count()/rounds;
+
+    cout << "accounts: " << accounts << endl;
+    cout << "interest posting: " << interest_ms << " ms/pass, " << interest_ms*1e6/accounts << " ns/account" << endl;
+    cout << "fee posting: " << fee_ms << " ms/pass, " << fee_ms*1e6/accounts << " ns/account" << endl;
+    cout << "total balance: " << before << " -> " << bank.total_balance() << endl;
+
+    // a balance close to the 64-bit limit must be rejected as a whole
+    bank.open_account(0, "", POOL_ACCOUNT, Money(), Money::from_cents(0x7fffffffffffffffLL-100));
+    Money total = bank.total_balance();
+    bool posted = bank.post_interest(12500);
+    cout << "overflow detected: " << (!posted && bank.total_balance() == total ? "yes" : "no") << endl;
+
+    return(0);
+}
@@ -0,0 +1,77 @@
+#include "poolbank.h"
+#include "cccbank.h"
+
+#include "checking.h"
+
+#include <chrono>
+#include <iostream>
+
+#include <stdlib.h>
+
+// open accounts, then measure random withdrawals and total balance scans
+// * returns the nanoseconds per withdrawal and per scanned account
+template <class B>
+void run(B &bank, int accounts, int ops, int scans, double *withdraw_ns, double *scan_ns)
+{
+    for (int i=1; i<=accounts; i++)
+        if (i%2) bank.open_account(i, "", new CheckingAccount(i%100, i%1000));
+        else bank.open_account(i, "", new Account(i%1000));
+
+    unsigned int state = 4711;
+    int successful = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int n=0; n<ops; n++)
+    {
+        state = state*1664525u+1013904223u;
+        successful += bank.withdraw(state%accounts+1, "", n%50);
+    }
+
+    chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+
+    Money total;
+    for (int n=0; n<scans; n++)
+        total += bank.total_balance();
+
+    chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+    *withdraw_ns = chrono::duration<double, nano>(middle-start).count()/ops;
+    *scan_ns = chrono::duration<double, nano>(stop-middle).count()/scans/accounts;
+
+    cerr << "(successful withdrawals: " << successful << ", total balance: " << total.euro()/scans << ")" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int accounts = 1000000;
+    int ops = 10000000;
+    int scans = 20;
+
+    if (argc > 1) accounts = atoi(argv[1]);
+    if (argc > 2) ops = atoi(argv[2]);
+
+    double pointer_withdraw, pointer_scan;
+    double pool_withdraw, pool_scan;
+
+    // silence the event log of the accounts and the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    // pointer-based accounts on the heap
+    {
+        CCCBank bank(accounts);
+        run(bank, accounts, ops, scans, &pointer_withdraw, &pointer_scan);
+    }
+
+    // pooled accounts with type tags
+    {
+        PoolBank bank(accounts);
+        run(bank, accounts, ops, scans, &pool_withdraw, &pool_scan);
+    }
+
+    cout << "accounts: " << accounts << endl;
+    cout << "withdraw: pointer " << pointer_withdraw << " ns, pool " << pool_withdraw << " ns, speedup " << pointer_withdraw/pool_withdraw << endl;
+    cout << "total_balance: pointer " << pointer_scan << " ns/account, pool " << pool_scan << " ns/account, speedup " << pointer_scan/pool_scan << endl;
+
+    return(0);
+}
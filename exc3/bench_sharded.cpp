@@ -0,0 +1,86 @@
+#include "lockedbank.h"
+#include "shardedbank.h"
+
+#include "checking.h"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+// replay the deposit and transfer pattern of main.cpp
+// * each thread works on its own block of 100 accounts
+// * every fourth transfer crosses over to the block of the neighbouring thread
+void replay(Bank *bank, int thread, int threads, int rounds)
+{
+    int base = 100*thread;
+    int next = 100*((thread+1)%threads);
+
+    for (int r=0; r<rounds; r++)
+    {
+        for (int i=1; i<=100; i++)
+            bank->deposit(base+(271*(i-1)+17)%100+1, i);
+        for (int i=1; i<=100; i++)
+            bank->transfer(base+(271*(i-1)+71)%100+1, ((i&3)==0?next:base)+i, "", i);
+    }
+}
+
+// run the replay on a number of threads and return the operations per second
+template <class B>
+double run(int threads, int rounds, Money *total)
+{
+    B bank;
+
+    for (int i=1; i<=100*threads; i++)
+        bank.open_account(i, "", new CheckingAccount(i));
+
+    vector<thread> workers;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int t=0; t<threads; t++)
+        workers.push_back(thread(replay, &bank, t, threads, rounds));
+    for (int t=0; t<threads; t++)
+        workers[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    *total = bank.total_balance();
+
+    return 200.0*rounds*threads/elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    int max_threads = thread::hardware_concurrency();
+    int rounds = 2000;
+
+    if (argc > 1) max_threads = atoi(argv[1]);
+    if (argc > 2) rounds = atoi(argv[2]);
+    if (max_threads < 1) max_threads = 1;
+
+    // silence the event log of the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    for (int threads=1; ; threads=min(2*threads, max_threads))
+    {
+        Money expected = 5050.0*rounds*threads;
+        Money total1, total2;
+
+        double ops1 = run<LockedBank<CCCBank> >(threads, rounds, &total1);
+        double ops2 = run<ShardedBank>(threads, rounds, &total2);
+
+        cerr << "threads: " << threads
+             << ", locked: " << ops1 << " ops/s"
+             << ", sharded: " << ops2 << " ops/s"
+             << ", speedup: " << ops2/ops1
+             << (total2 == expected ? "" : " (total balance mismatch)") << endl;
+
+        if (threads == max_threads) break;
+    }
+
+    return(0);
+}
@@ -0,0 +1,105 @@
+#include "lockedbank.h"
+#include "shardedbank.h"
+#include "transaction.h"
+
+#include "checking.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+static const int employees = 10000;
+
+// payroll: every transaction reads the balance of an employer,
+// withdraws the sum of the salaries and deposits one salary on each of "fanout" employees
+// * the employers are shared by all threads, fewer employers mean more conflicts
+// * returns the committed transactions per second
+template <class B>
+double run(int threads, int employers, int fanout, int transactions, double *retries, bool *balanced)
+{
+    B bank;
+
+    for (int i=1; i<=employers; i++)
+        bank.open_account(i, "employer", new Account(1e9));
+    for (int i=1; i<=employees; i++)
+        bank.open_account(employers+i, "", new CheckingAccount(100));
+
+    Money total = bank.total_balance();
+
+    atomic<long long> attempts(0), committed(0);
+    vector<thread> workers;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int t=0; t<threads; t++)
+        workers.push_back(thread([&bank, &attempts, &committed, t, employers, fanout, transactions]() {
+            unsigned int state = 4711+t;
+
+            for (int n=0; n<transactions; n++) {
+                state = state*1664525u+1013904223u;
+                int employer = state%employers+1;
+                int first = state/employers%employees;
+
+                TransactionResult result = run_transaction(&bank, [&](Transaction &tx) {
+                    attempts++;
+
+                    Money balance;
+                    if (!tx.read(employer, "employer", &balance)) return false;
+                    if (balance < Money(10.0*fanout)) return false;
+
+                    tx.withdraw(employer, "employer", Money(10.0*fanout));
+                    for (int i=0; i<fanout; i++)
+                        tx.deposit(employers+(first+i)%employees+1, 10);
+
+                    return true;
+                });
+
+                if (result == TX_COMMITTED) committed++;
+            }
+        }));
+
+    for (int t=0; t<threads; t++)
+        workers[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    *retries = (double)(attempts-committed)/committed;
+    *balanced = (bank.total_balance() == total && committed == (long long)threads*transactions);
+
+    return committed/elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    int max_threads = 4;
+    int max_fanout = 1000;
+
+    if (argc > 1) max_threads = atoi(argv[1]);
+    if (argc > 2) max_fanout = atoi(argv[2]);
+
+    // silence the event log of the accounts
+    event_log().set_level(LOG_OFF);
+
+    for (int threads=1; threads<=max_threads; threads*=2)
+        for (int employers=1; employers<=16; employers*=16)
+            for (int fanout=1; fanout<=max_fanout; fanout*=10)
+            {
+                int transactions = 100000/fanout/threads+10;
+                double retries1, retries2;
+                bool balanced1, balanced2;
+
+                double tps1 = run<LockedBank<CCCBank> >(threads, employers, fanout, transactions, &retries1, &balanced1);
+                double tps2 = run<ShardedBank>(threads, employers, fanout, transactions, &retries2, &balanced2);
+
+                cout << "threads: " << threads << ", employers: " << employers << ", fanout: " << fanout
+                     << ", locked: " << tps1 << " commits/s (" << retries1 << " retries/commit)"
+                     << ", sharded: " << tps2 << " commits/s (" << retries2 << " retries/commit)"
+                     << (balanced1 && balanced2 ? "" : " (balance mismatch)") << endl;
+            }
+
+    return(0);
+}
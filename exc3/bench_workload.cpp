@@ -0,0 +1,293 @@
+#include "lockedbank.h"
+#include "cccbank.h"
+#include "poolbank.h"
+#include "shardedbank.h"
+
+#include "checking.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+
+// workload parameters
+// * given on the command line as name=value, e.g. "bank=sharded threads=4 zipf=0.99"
+struct Workload
+{
+    string bank = "sharded";   // ccc, pool (both behind one lock) or sharded
+    int accounts = 10000;
+    int ops = 1000000;         // operations per thread
+    int threads = 1;
+    int reads = 40;            // mix of balance queries,
+    int deposits = 20;         // deposits,
+    int withdraws = 20;        // withdrawals
+    int transfers = 20;        // and transfers in percent
+    double zipf = 0.0;         // skew of the account popularity, 0 is uniform
+    int fanout = 1;            // number of targets of a transfer, more than one is sent as a batch
+    double invalid = 0.0;      // rate of wrong passwords
+    unsigned long long seed = 4711;
+};
+
+// reproducible random numbers (splitmix64)
+class Random
+{
+public:
+
+    Random(unsigned long long seed) : state_(seed) {}
+
+    unsigned long long next() {
+        unsigned long long z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0,1)
+    double uniform() {
+        return (next() >> 11)*(1.0/9007199254740992.0);
+    }
+
+protected:
+
+    unsigned long long state_;
+};
+
+// Zipf-distributed account numbers
+// * rank r is drawn with a probability proportional to 1/r^theta
+// * the ranks are shuffled onto the account numbers, so the hot accounts are spread over the bank
+class ZipfAccounts
+{
+public:
+
+    ZipfAccounts(int accounts, double theta, unsigned long long seed)
+        : cdf_(accounts), accounts_(accounts) {
+        double sum = 0;
+        for (int r=0; r<accounts; r++) cdf_[r] = (sum += 1.0/pow(r+1.0, theta));
+        for (int r=0; r<accounts; r++) cdf_[r] /= sum;
+
+        Random random(seed);
+        for (int r=0; r<accounts; r++) accounts_[r] = r+1;
+        for (int r=accounts-1; r>0; r--) swap(accounts_[r], accounts_[random.next()%(r+1)]);
+    }
+
+    int next(Random &random) const {
+        int r = lower_bound(cdf_.begin(), cdf_.end(), random.uniform())-cdf_.begin();
+        return accounts_[min(r, (int)accounts_.size()-1)];
+    }
+
+protected:
+
+    vector<double> cdf_;
+    vector<int> accounts_;
+};
+
+// results of one worker thread
+struct WorkerResult
+{
+    vector<unsigned int> latency; // nanoseconds per operation
+    vector<long long> delta;      // expected balance change per account in cents
+    unsigned long long successful = 0;
+    unsigned long long failed = 0;
+};
+
+string password(int account_nr)
+{
+    return "passwd-" + to_string(account_nr % 1000);
+}
+
+// run the operations of one thread
+void work(Bank *bank, const Workload &w, const ZipfAccounts &zipf, const vector<string> &passwds, int thread, WorkerResult *result)
+{
+    Random random(w.seed*1000003ULL+thread);
+    vector<TransferRecord> batch(w.fanout);
+
+    result->latency.resize(w.ops);
+    result->delta.assign(w.accounts+1, 0);
+
+    int mix = w.reads+w.deposits+w.withdraws+w.transfers;
+
+    for (int n=0; n<w.ops; n++)
+    {
+        int op = random.next()%mix;
+        int account = zipf.next(random);
+        Money amount = Money::from_cents(random.next()%10000+1);
+        string_view passwd = random.uniform() < w.invalid ? string_view("wrong") : string_view(passwds[account]);
+
+        bool ok = true;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        if ((op -= w.reads) < 0) {
+            bank->balance(account, passwd);
+        } else if ((op -= w.deposits) < 0) {
+            ok = bank->deposit(account, amount);
+            if (ok) result->delta[account] += amount.cents();
+        } else if ((op -= w.withdraws) < 0) {
+            ok = bank->withdraw(account, passwd, amount);
+            if (ok) result->delta[account] -= amount.cents();
+        } else if (w.fanout <= 1) {
+            int to = zipf.next(random);
+            ok = bank->transfer(account, to, passwd, amount);
+            if (ok) {
+                result->delta[account] -= amount.cents();
+                result->delta[to] += amount.cents();
+            }
+        } else {
+            for (int i=0; i<w.fanout; i++) {
+                batch[i].from = account;
+                batch[i].to = zipf.next(random);
+                batch[i].passwd = passwd;
+                batch[i].amount = amount;
+            }
+            vector<bool> results = bank->transfer_batch(batch.data(), w.fanout);
+            for (int i=0; i<w.fanout; i++)
+                if (results[i]) {
+                    result->delta[account] -= amount.cents();
+                    result->delta[batch[i].to] += amount.cents();
+                } else {
+                    ok = false;
+                }
+        }
+
+        result->latency[n] = chrono::duration<double, nano>(chrono::steady_clock::now()-start).count();
+
+        if (ok) result->successful++;
+        else result->failed++;
+    }
+}
+
+// open the accounts and run the workload
+// * returns false if the final balances do not match the successful operations
+bool run(Bank *bank, const Workload &w)
+{
+    vector<string> passwds(w.accounts+1);
+    vector<long long> expected(w.accounts+1);
+
+    for (int i=1; i<=w.accounts; i++) {
+        passwds[i] = password(i);
+        expected[i] = Money(1000).cents();
+        bank->open_account(i, passwds[i], i%2 ? new CheckingAccount(500, 1000) : new Account(1000));
+    }
+
+    ZipfAccounts zipf(w.accounts, w.zipf, w.seed);
+    vector<WorkerResult> results(w.threads);
+    vector<thread> workers;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (int t=0; t<w.threads; t++)
+        workers.push_back(thread(work, bank, cref(w), cref(zipf), cref(passwds), t, &results[t]));
+    for (int t=0; t<w.threads; t++)
+        workers[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now()-start;
+
+    // merge the latencies and balance changes
+    vector<unsigned int> latency;
+    unsigned long long successful = 0, failed = 0;
+
+    for (int t=0; t<w.threads; t++) {
+        latency.insert(latency.end(), results[t].latency.begin(), results[t].latency.end());
+        for (int i=1; i<=w.accounts; i++) expected[i] += results[t].delta[i];
+        successful += results[t].successful;
+        failed += results[t].failed;
+    }
+
+    sort(latency.begin(), latency.end());
+
+    // verify the final balances and compute their checksum (FNV-1a)
+    long long expected_total = 0;
+    unsigned long long checksum = 14695981039346656037ULL;
+    int mismatches = 0;
+
+    for (int i=1; i<=w.accounts; i++) {
+        long long cents = bank->balance(i, passwds[i]).cents();
+        if (cents != expected[i]) mismatches++;
+        expected_total += expected[i];
+
+        for (int b=0; b<8; b++) checksum = (checksum ^ ((cents >> (8*b)) & 0xff))*1099511628211ULL;
+    }
+
+    bool total_ok = bank->total_balance().cents() == expected_total;
+    unsigned long long ops = (unsigned long long)w.ops*w.threads;
+
+    cout << "bank: " << w.bank << ", threads: " << w.threads << ", accounts: " << w.accounts
+         << ", mix: " << w.reads << "/" << w.deposits << "/" << w.withdraws << "/" << w.transfers
+         << ", zipf: " << w.zipf << ", fanout: " << w.fanout << ", invalid: " << w.invalid << ", seed: " << w.seed << endl;
+    cout << "throughput: " << ops/elapsed.count() << " ops/s"
+         << ", successful: " << successful << ", failed: " << failed << endl;
+    cout << "latency: p50 " << latency[ops/2] << " ns"
+         << ", p99 " << latency[ops*99/100] << " ns"
+         << ", p999 " << latency[ops*999/1000] << " ns" << endl;
+    cout << "balances: " << (mismatches == 0 && total_ok ? "verified" : "MISMATCH")
+         << " (" << mismatches << " accounts differ), checksum: " << hex << checksum << dec << endl;
+
+    return mismatches == 0 && total_ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Workload w;
+
+    for (int i=1; i<argc; i++)
+    {
+        const char *value = strchr(argv[i], '=');
+        if (value == NULL) {
+            cerr << "usage: " << argv[0] << " [bank=ccc|pool|sharded] [accounts=n] [ops=n] [threads=n]"
+                 << " [reads=%] [deposits=%] [withdraws=%] [transfers=%] [zipf=theta] [fanout=n] [invalid=rate] [seed=n]" << endl;
+            return(1);
+        }
+
+        string name(argv[i], value-argv[i]);
+        value++;
+
+        if (name == "bank") w.bank = value;
+        else if (name == "accounts") w.accounts = atoi(value);
+        else if (name == "ops") w.ops = atoi(value);
+        else if (name == "threads") w.threads = atoi(value);
+        else if (name == "reads") w.reads = atoi(value);
+        else if (name == "deposits") w.deposits = atoi(value);
+        else if (name == "withdraws") w.withdraws = atoi(value);
+        else if (name == "transfers") w.transfers = atoi(value);
+        else if (name == "zipf") w.zipf = atof(value);
+        else if (name == "fanout") w.fanout = atoi(value);
+        else if (name == "invalid") w.invalid = atof(value);
+        else if (name == "seed") w.seed = strtoull(value, NULL, 10);
+        else {
+            cerr << "unknown parameter " << name << endl;
+            return(1);
+        }
+    }
+
+    if (w.accounts < 1 || w.ops < 1 || w.threads < 1 || w.fanout < 1 ||
+        w.reads < 0 || w.deposits < 0 || w.withdraws < 0 || w.transfers < 0 ||
+        w.reads+w.deposits+w.withdraws+w.transfers <= 0) {
+        cerr << "invalid workload" << endl;
+        return(1);
+    }
+
+    // silence the event log of the accounts and the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    Bank *bank;
+
+    if (w.bank == "ccc") bank = new LockedBank<CCCBank>(w.accounts);
+    else if (w.bank == "pool") bank = new LockedBank<PoolBank>(w.accounts);
+    else if (w.bank == "sharded") bank = new ShardedBank();
+    else {
+        cerr << "unknown bank " << w.bank << endl;
+        return(1);
+    }
+
+    bool verified = run(bank, w);
+
+    delete bank;
+
+    return(verified ? 0 : 2);
+}
@@ -1,31 +1,95 @@
 #pragma once
 
 #include "bank.h"
-#include <iostream>
+#include "accountindex.h"
+#include "digest.h"
+#include "eventlog.h"
+#include "transaction.h"
 #include <string>
-#include <map>
+#include <string_view>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
 // account with associated protection password
+// * only the digest of the password is stored
+// * the version is incremented with every change of the balance
 class ProtectedAccount
 {
 public:
 
-    ProtectedAccount(Account *a, string p)
-        : account(a), passwd(p) {}
+    ProtectedAccount()
+        : account(NULL), version(0) {}
+
+    ProtectedAccount(Account *a, const PasswordDigest &d)
+        : account(a), digest(d), version(0) {}
+
+    // return true if passwd matches the account password
+    bool verify(int account_nr, string_view passwd) const {
+        return CredentialCache::verify(account_nr, digest, passwd);
+    }
 
     Account *account; // public -> no getter required
-    string passwd; // public -> no getter required
+    PasswordDigest digest; // public -> no getter required
+    unsigned long long version; // public -> no getter required
 
 };
 
+// validate and apply a transaction
+// * "find" maps an account number to its protected account or NULL
+// * "booked" is called with the account number and the signed amount of each applied write
+// * the caller must protect all accounts of the transaction from concurrent changes
+// * the writes are applied in order, if a withdrawal is declined the applied writes are undone
+template <class Find, class Booked>
+TransactionResult apply_transaction(const Transaction &tx, Find find, Booked booked)
+{
+    const vector<TransactionRead> &reads = tx.reads();
+    const vector<TransactionWrite> &writes = tx.writes();
+
+    // validation pass
+    for (size_t i = 0; i < reads.size(); i++) {
+        ProtectedAccount *it = find(reads[i].account);
+        if (it == NULL || it->version != reads[i].version) return TX_CONFLICT;
+    }
+
+    // authentication pass
+    vector<ProtectedAccount *> accounts(writes.size());
+
+    for (size_t i = 0; i < writes.size(); i++) {
+        accounts[i] = find(writes[i].account);
+        if (accounts[i] == NULL || writes[i].amount <= Money()) return TX_INVALID;
+        if (writes[i].withdraw && !accounts[i]->verify(writes[i].account, writes[i].passwd)) return TX_DENIED;
+    }
+
+    // booking pass
+    for (size_t i = 0; i < writes.size(); i++) {
+        if (!writes[i].withdraw) {
+            accounts[i]->account->deposit(writes[i].amount);
+        } else if (!accounts[i]->account->withdraw(writes[i].amount)) {
+            // undo in reverse order, so every step restores a state that existed before
+            while (i-- > 0)
+                if (writes[i].withdraw) accounts[i]->account->deposit(writes[i].amount);
+                else accounts[i]->account->withdraw(writes[i].amount);
+            return TX_DECLINED;
+        }
+    }
+
+    for (size_t i = 0; i < writes.size(); i++) {
+        accounts[i]->version++;
+        booked(writes[i].account, writes[i].withdraw ? -writes[i].amount : writes[i].amount);
+    }
+
+    return TX_COMMITTED;
+}
+
 // CCC-Bank
 class CCCBank: public Bank
 {
 public:
 
-    CCCBank() : Bank() {}
+    CCCBank(unsigned int capacity = 16)
+        : Bank(), accounts_(capacity), total_() {}
 
     ~CCCBank() {}
 
@@ -34,42 +98,97 @@ public:
     // * password "passwd"
     // * and a reference "a" to a new account
     // * returns true if the account could be opened successfully
-    bool open_account(int account_nr, string passwd, Account *a) {
-        ProtectedAccount new_account = ProtectedAccount(a, passwd);
-        accounts_.insert(pair<int, ProtectedAccount>(account_nr, new_account));
-        cout << "Account (nr: "<< account_nr <<", passwd: "<< passwd <<") created with a balance of EUR: "<< a->balance() << std::endl;
-        
-        if (account_nr == accounts_.find(account_nr)->first) return true;
-        
-        return false;
+    bool open_account(int account_nr, string_view passwd, Account *a) {
+        ProtectedAccount new_account = ProtectedAccount(a, PasswordDigest::of(account_nr, passwd));
+        bool created = accounts_.insert(account_nr, new_account).second;
+        if (created) {
+            total_ += a->balance();
+            event_log().log(LOG_INFO, EVENT_ACCOUNT_OPENED, account_nr, 0, a->balance());
+        } else {
+          event_log().log(LOG_WARNING, EVENT_ACCOUNT_TAKEN, account_nr);
+        }
+
+        return created;
+    }
+
+    // restore an account without notification
+    // * used when rebuilding a bank from a snapshot
+    // * returns true if the account number was not already taken
+    bool restore_account(int account_nr, const PasswordDigest &digest, Account *a) {
+        if (!accounts_.insert(account_nr, ProtectedAccount(a, digest)).second) return false;
+        total_ += a->balance();
+        return true;
+    }
+
+    // withdraw amount from account without authentication
+    // * used when replaying already authorized operations from a journal
+    // * returns true if the withdrawal was successful
+    bool restore_withdraw(int account_nr, Money amount) {
+        ProtectedAccount *it = accounts_.find(account_nr);
+        if (it == NULL || !it->account->withdraw(amount)) return false;
+
+        it->version++;
+        total_ -= amount;
+
+        return true;
+    }
+
+    // transfer amount from one account to another one without authentication
+    // * used when replaying already authorized operations from a journal
+    // * returns true if the transfer was successful
+    bool restore_transfer(int from, int to, Money amount) {
+        ProtectedAccount *it_from = accounts_.find(from);
+        ProtectedAccount *it_to = accounts_.find(to);
+
+        if (it_from == NULL || it_to == NULL || !it_from->account->withdraw(amount)) return false;
+
+        it_to->account->deposit(amount);
+        it_from->version++;
+        it_to->version++;
+
+        return true;
+    }
+
+    // call f(account_nr, protected_account) for all accounts
+    template <class F>
+    void for_each_account(F f) {
+        accounts_.for_each(f);
     }
 
     // deposit amount on account
     // * if account is existing
-    void deposit(int account_nr, double amount) {
-        map<int, ProtectedAccount>::iterator it;
+    // * returns true if the deposit was successful
+    bool deposit(int account_nr, Money amount) {
+        ProtectedAccount *it;
         
         it = accounts_.find(account_nr);
-        if (account_nr == it->first) {
-            (it->second).account->deposit(amount);
+        if (it != NULL) {
+            if (!it->account->deposit(amount)) return false;
+            it->version++;
+            total_ += amount;
+            return true;
         } else {
-          cout << "# deposit failed: no matching account = " << account_nr << endl; 
+          event_log().log(LOG_WARNING, EVENT_DEPOSIT_FAILED, account_nr);
         }
+        
+        return false;
     }
 
     // withdraw amount from account
     // * if account is existing
     // * and if passwd matches the account password
     // * returns true if the withdrawal was successful
-    bool withdraw(int account_nr, string passwd, double amount) {
-        map<int, ProtectedAccount>::iterator it;
+    bool withdraw(int account_nr, string_view passwd, Money amount) {
+        ProtectedAccount *it;
         
         it = accounts_.find(account_nr);
-        if (account_nr == it->first && passwd.compare((it->second).passwd) == 0) {
-            (it->second).account->withdraw(amount);
+        if (it != NULL && it->verify(account_nr, passwd)) {
+            if (!it->account->withdraw(amount)) return false;
+            it->version++;
+            total_ -= amount;
             return true;
         } else {
-          cout << "# withdraw failed: no matching account = " << account_nr << " with passwd = " << passwd << endl;
+          event_log().log(LOG_WARNING, EVENT_WITHDRAW_FAILED, account_nr);
         }
         
         return false;
@@ -80,51 +199,128 @@ public:
     // * and if passwd matches the account password
     // * and if the withdrawal was successful
     // * returns true if the transfer was successful
-    bool transfer(int from, int to, string passwd, double amount) {
-        map<int, ProtectedAccount>::iterator it_from;
-        map<int, ProtectedAccount>::iterator it_to;
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        ProtectedAccount *it_from;
+        ProtectedAccount *it_to;
         
         it_from = accounts_.find(from);
         it_to = accounts_.find(to);
-        if ((from == it_from->first && to == it_to->first) && (passwd.compare((it_from->second).passwd) == 0)) {
-            (it_from->second).account->withdraw(amount);
-            (it_to->second).account->deposit(amount);
-            cout << "# transfered amount: "<< amount <<"; from "<< from <<" -> to "<< to <<" successfully" << endl;
+        if ((it_from != NULL && it_to != NULL) && it_from->verify(from, passwd)) {
+            if (!it_from->account->withdraw(amount)) {
+                event_log().log(LOG_INFO, EVENT_TRANSFER_DECLINED, from, to, amount);
+                return false;
+            }
+            it_to->account->deposit(amount);
+            it_from->version++;
+            it_to->version++;
+            event_log().log(LOG_INFO, EVENT_TRANSFERED, from, to, amount);
             return true;
         } else {
-          cout << "# transfer failed: matching from->to correct= "<< (from == it_from->first && to == it_to->first) <<", pass correct= "<< passwd.compare((it_from->second).passwd) << endl;
+          unsigned short flags = 0;
+          if (it_from != NULL && it_to != NULL) flags |= EVENT_ACCOUNTS_FOUND;
+          if (it_from != NULL && it_from->verify(from, passwd)) flags |= EVENT_PASSWD_CORRECT;
+          event_log().log(LOG_WARNING, EVENT_TRANSFER_FAILED, from, to, amount, flags);
         }
         
         return false;
     }
 
+    // transfer a batch of "count" records
+    // * the records are grouped by source account and password,
+    //   so each source account is looked up and authenticated once per batch
+    // * the withdrawals and deposits are then applied in one pass in the given order,
+    //   so the results are the same as for single transfers
+    // * returns the result of each transfer
+    vector<bool> transfer_batch(const TransferRecord *records, unsigned int count) {
+        vector<bool> results(count);
+        vector<unsigned int> order(count);
+        vector<ProtectedAccount *> sources(count);
+
+        for (unsigned int i = 0; i < count; i++) order[i] = i;
+
+        sort(order.begin(), order.end(), [records](unsigned int a, unsigned int b) {
+            if (records[a].from != records[b].from) return records[a].from < records[b].from;
+            return records[a].passwd < records[b].passwd;
+        });
+
+        // authentication pass
+        for (unsigned int i = 0; i < count; ) {
+            const TransferRecord &first = records[order[i]];
+
+            ProtectedAccount *it_from = accounts_.find(first.from);
+            if (it_from != NULL && !it_from->verify(first.from, first.passwd)) it_from = NULL;
+
+            do {
+                sources[order[i++]] = it_from;
+            } while (i < count && records[order[i]].from == first.from && records[order[i]].passwd == first.passwd);
+        }
+
+        // booking pass
+        unsigned int successful = 0;
+
+        for (unsigned int i = 0; i < count; i++) {
+            ProtectedAccount *it_from = sources[i];
+            ProtectedAccount *it_to = accounts_.find(records[i].to);
+
+            if (it_from != NULL && it_to != NULL && it_from->account->withdraw(records[i].amount)) {
+                it_to->account->deposit(records[i].amount);
+                it_from->version++;
+                it_to->version++;
+                results[i] = true;
+                successful++;
+            }
+        }
+
+        event_log().log(LOG_INFO, EVENT_BATCH_TRANSFERED, 0, 0, Money(), 0, count, successful);
+
+        return results;
+    }
+
     // return the account balance
     // * if account is existing
     // * and if passwd matches the account password
-    double balance(int account_nr, string passwd) {
-        map<int, ProtectedAccount>::iterator it;
+    Money balance(int account_nr, string_view passwd) {
+        ProtectedAccount *it;
         
         it = accounts_.find(account_nr);
-        if (account_nr == it->first && passwd.compare((it->second).passwd)) {
-            return ((it->second).account->balance());
+        if (it != NULL && it->verify(account_nr, passwd)) {
+            return (it->account->balance());
         } else {
-          cout << "# withdraw failed: no matching account = " << account_nr << " with passwd = " << passwd << endl;
+          event_log().log(LOG_WARNING, EVENT_BALANCE_FAILED, account_nr);
         }
         return 0;
     }
 
     // return the total bank balance
     // * which is the sum of all account balances
-    double total_balance() { 
-        //map<int, ProtectedAccount>::iterator it;
-        double total = 0;
-        
-        for (auto it : accounts_) { 
-          total += (it.second).account->balance();
-        }
-        return total; 
+    // * maintained incrementally by all operations, so no accounts are visited
+    Money total_balance() { 
+        return total_; 
+    }
+
+    // read the balance and the version of an account for a transaction
+    // * if account is existing
+    // * and if passwd matches the account password
+    bool read_version(int account_nr, string_view passwd, Money *balance, unsigned long long *version) {
+        ProtectedAccount *it = accounts_.find(account_nr);
+        if (it == NULL || !it->verify(account_nr, passwd)) return false;
+
+        *balance = it->account->balance();
+        *version = it->version;
+
+        return true;
+    }
+
+    // validate and apply a transaction atomically
+    // * the CCC-Bank is not concurrent, so a conflict only occurs
+    //   if the accounts were changed between the reads and the commit
+    TransactionResult commit(const Transaction &tx) {
+        return apply_transaction(tx,
+                                 [this](int account_nr) { return accounts_.find(account_nr); },
+                                 [this](int, Money amount) { total_ += amount; });
     }
 
 protected:
-    map<int, ProtectedAccount> accounts_;
+    AccountIndex<ProtectedAccount> accounts_;
+    Money total_; // sum of all account balances
 };
@@ -3,10 +3,15 @@
   module: implements the checking account class
 */
 #include "checking.h"
-#include <iostream>
+#include "eventlog.h"
 
 // Constructor
-CheckingAccount::CheckingAccount(double giro_limit) : Account() {
+CheckingAccount::CheckingAccount(Money giro_limit) : Account() {
+  giro_ = giro_limit;
+}
+
+// Constructor with initial balance
+CheckingAccount::CheckingAccount(Money giro_limit, Money balance) : Account(balance) {
   giro_ = giro_limit;
 }
 
@@ -14,15 +19,14 @@ CheckingAccount::CheckingAccount(double giro_limit) : Account() {
 CheckingAccount::~CheckingAccount() {}
 
 // Getter
-double CheckingAccount::get_giro() {
+Money CheckingAccount::get_giro() {
   return giro_;
 }
 
 // Setter
-bool CheckingAccount::withdraw(double euro) {
+bool CheckingAccount::withdraw(Money euro) {
   if (euro < 0.0) {
-    std::cout << "Operation invalid: We appreciate your donation very much, " 
-    << "unfortunately we are not allowed to accept it in this way." << std::endl;
+    event_log().log(LOG_WARNING, EVENT_INVALID_WITHDRAW, 0, 0, euro);
     return false;
   }
   if ((balance_ + giro_ - euro) >= 0) {
@@ -9,15 +9,16 @@
 class CheckingAccount : public Account
 {
 public:
-  CheckingAccount(double giro_limit = 0.0); // Constructor
-  ~CheckingAccount();                       // Dectructor
+  CheckingAccount(Money giro_limit = Money());      // Constructor
+  CheckingAccount(Money giro_limit, Money balance); // Constructor with initial balance
+  ~CheckingAccount();                               // Dectructor
   
   // Getter
-  double get_giro();
+  Money get_giro();
   
   // Setter
-  bool withdraw(double euro);
+  bool withdraw(Money euro);
 
 private:
-  double giro_;
+  Money giro_;
 };
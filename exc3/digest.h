@@ -0,0 +1,213 @@
+#pragma once
+
+#include <string.h>
+#include <string_view>
+
+using namespace std;
+
+// SHA-256 digest of an account password
+// * the account number is hashed in front of the password as salt,
+//   so equal passwords of different accounts have different digests
+// * the digest is stored inline (32 bytes), no heap allocation
+class PasswordDigest
+{
+public:
+
+    static const unsigned int size = 32;
+
+    PasswordDigest() {
+        memset(bytes_, 0, size);
+    }
+
+    // digest of the password of an account
+    static PasswordDigest of(int account_nr, string_view passwd) {
+        PasswordDigest d;
+        Sha256 sha;
+
+        unsigned char salt[4];
+        for (int i = 0; i < 4; i++) salt[i] = (unsigned int)account_nr >> (8*i);
+
+        sha.update(salt, 4);
+        sha.update((const unsigned char *)passwd.data(), passwd.size());
+        sha.finish(d.bytes_);
+
+        return d;
+    }
+
+    // construct from raw digest bytes
+    static PasswordDigest from_bytes(const unsigned char *bytes) {
+        PasswordDigest d;
+        memcpy(d.bytes_, bytes, size);
+        return d;
+    }
+
+    const unsigned char *bytes() const { return bytes_; }
+
+    // compare in constant time
+    // * all bytes are visited regardless of the first mismatch
+    bool equals(const PasswordDigest &d) const {
+        unsigned char diff = 0;
+        for (unsigned int i = 0; i < size; i++) diff |= bytes_[i] ^ d.bytes_[i];
+        return diff == 0;
+    }
+
+protected:
+
+    // minimal SHA-256 (FIPS 180-4)
+    class Sha256
+    {
+    public:
+
+        Sha256() : length_(0), fill_(0) {
+            static const unsigned int init[8] = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+            memcpy(state_, init, sizeof(init));
+        }
+
+        void update(const unsigned char *data, size_t n) {
+            length_ += n;
+
+            while (n > 0) {
+                size_t chunk = 64-fill_ < n ? 64-fill_ : n;
+                memcpy(block_+fill_, data, chunk);
+                fill_ += chunk;
+                data += chunk;
+                n -= chunk;
+
+                if (fill_ == 64) {
+                    compress();
+                    fill_ = 0;
+                }
+            }
+        }
+
+        void finish(unsigned char *digest) {
+            unsigned long long bits = length_*8;
+
+            unsigned char pad = 0x80;
+            update(&pad, 1);
+
+            pad = 0;
+            while (fill_ != 56) update(&pad, 1);
+
+            for (int i = 7; i >= 0; i--) block_[fill_++] = bits >> (8*i);
+            compress();
+
+            for (int i = 0; i < 8; i++)
+                for (int j = 0; j < 4; j++)
+                    digest[4*i+j] = state_[i] >> (24-8*j);
+        }
+
+    protected:
+
+        static unsigned int rotr(unsigned int x, int n) {
+            return (x >> n) | (x << (32-n));
+        }
+
+        void compress() {
+            static const unsigned int k[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+
+            unsigned int w[64];
+
+            for (int i = 0; i < 16; i++)
+                w[i] = (unsigned int)block_[4*i] << 24 | (unsigned int)block_[4*i+1] << 16 |
+                       (unsigned int)block_[4*i+2] << 8 | (unsigned int)block_[4*i+3];
+
+            for (int i = 16; i < 64; i++) {
+                unsigned int s0 = rotr(w[i-15], 7) ^ rotr(w[i-15], 18) ^ (w[i-15] >> 3);
+                unsigned int s1 = rotr(w[i-2], 17) ^ rotr(w[i-2], 19) ^ (w[i-2] >> 10);
+                w[i] = w[i-16]+s0+w[i-7]+s1;
+            }
+
+            unsigned int a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+            unsigned int e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+            for (int i = 0; i < 64; i++) {
+                unsigned int t1 = h+(rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25))+((e & f) ^ (~e & g))+k[i]+w[i];
+                unsigned int t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22))+((a & b) ^ (a & c) ^ (b & c));
+                h = g; g = f; f = e; e = d+t1;
+                d = c; c = b; b = a; a = t1+t2;
+            }
+
+            state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+            state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+        }
+
+        unsigned int state_[8];
+        unsigned char block_[64];
+        unsigned long long length_;
+        size_t fill_;
+    };
+
+    unsigned char bytes_[size];
+};
+
+// per-thread cache of recently verified credentials
+// * an entry remembers a password that matched a stored digest of an account,
+//   so repeated operations of one session skip the hashing
+// * a hit requires the same account, the same password and the same stored digest,
+//   so a changed password or another bank never matches a stale entry
+// * passwords longer than the inline entry are always hashed
+class CredentialCache
+{
+public:
+
+    static const unsigned int entries = 16;
+    static const unsigned int max_length = 32;
+
+    // verify a password against the stored digest of an account
+    static bool verify(int account_nr, const PasswordDigest &stored, string_view passwd) {
+        Entry &entry = cache()[(unsigned int)account_nr % entries];
+
+        if (entry.valid && entry.account == account_nr && entry.length == passwd.size() &&
+            same(entry.passwd, passwd) && entry.digest.equals(stored))
+            return true;
+
+        if (!PasswordDigest::of(account_nr, passwd).equals(stored)) return false;
+
+        if (passwd.size() <= max_length) {
+            entry.valid = true;
+            entry.account = account_nr;
+            entry.length = passwd.size();
+            memcpy(entry.passwd, passwd.data(), passwd.size());
+            entry.digest = stored;
+        }
+
+        return true;
+    }
+
+protected:
+
+    struct Entry
+    {
+        Entry() : valid(false), account(0), length(0) {}
+
+        bool valid;
+        int account;
+        unsigned int length;
+        char passwd[max_length];
+        PasswordDigest digest;
+    };
+
+    static Entry *cache() {
+        static thread_local Entry cache[entries];
+        return cache;
+    }
+
+    // compare in constant time for a given length
+    static bool same(const char *a, string_view b) {
+        unsigned char diff = 0;
+        for (size_t i = 0; i < b.size(); i++) diff |= a[i] ^ b[i];
+        return diff == 0;
+    }
+};
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "money.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// log levels
+enum LogLevel
+{
+    LOG_DEBUG = 0,
+    LOG_INFO = 1,
+    LOG_WARNING = 2,
+    LOG_ERROR = 3,
+    LOG_OFF = 4
+};
+
+// log event types
+enum LogEventType
+{
+    EVENT_ACCOUNT_OPENED = 1,
+    EVENT_ACCOUNT_TAKEN = 2,
+    EVENT_ACCOUNT_CLOSED = 3,
+    EVENT_INVALID_DEPOSIT = 4,
+    EVENT_INVALID_WITHDRAW = 5,
+    EVENT_DEPOSIT_FAILED = 6,
+    EVENT_WITHDRAW_FAILED = 7,
+    EVENT_BALANCE_FAILED = 8,
+    EVENT_TRANSFER_DECLINED = 9,
+    EVENT_TRANSFERED = 10,
+    EVENT_TRANSFER_FAILED = 11,
+    EVENT_BATCH_TRANSFERED = 12
+};
+
+// flags of a failed transfer
+enum LogEventFlags
+{
+    EVENT_ACCOUNTS_FOUND = 1,
+    EVENT_PASSWD_CORRECT = 2
+};
+
+// fixed-size binary log record (32 bytes)
+// * passwords are never logged
+struct LogEvent
+{
+    unsigned char type;
+    unsigned char level;
+    unsigned short flags;
+    int account;
+    int to;                  // target account of a transfer
+    unsigned int count;      // number of transfers of a batch
+    unsigned int successful; // number of successful transfers of a batch
+    long long amount;        // amount in cents
+};
+
+// asynchronous event log
+// * producers copy a fixed-size record into a lock-free ring buffer and never block or format
+// * if the ring buffer is full the event is dropped and counted
+// * a background consumer formats the records and writes them with one flush per batch
+// * events below the log level are discarded before they are queued, the level can be changed at any time
+class EventLog
+{
+public:
+
+    EventLog(ostream *out = &cout, unsigned int capacity = 1<<14, LogLevel level = LOG_INFO)
+        : out_(out), level_(level), head_(0), tail_(0), written_(0), dropped_(0), stop_(false) {
+        unsigned int size = 1;
+        while (size < capacity) size *= 2;
+
+        cells_ = vector<LogCell>(size);
+        for (unsigned int i = 0; i < size; i++) cells_[i].sequence.store(i, memory_order_relaxed);
+        mask_ = size-1;
+
+        consumer_ = thread(&EventLog::consume_loop, this);
+    }
+
+    // write all queued events and stop the consumer
+    ~EventLog() {
+        {
+            lock_guard<mutex> guard(lock_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        consumer_.join();
+    }
+
+    // set the minimum level of the logged events
+    void set_level(LogLevel level) {
+        level_.store(level, memory_order_relaxed);
+    }
+
+    LogLevel level() const {
+        return (LogLevel)level_.load(memory_order_relaxed);
+    }
+
+    // return true if events of that level are logged
+    bool enabled(LogLevel level) const {
+        return level >= level_.load(memory_order_relaxed);
+    }
+
+    // log an event
+    // * returns false if the event was discarded or dropped
+    bool log(LogLevel level, LogEventType type, int account = 0, int to = 0, Money amount = Money(),
+             unsigned short flags = 0, unsigned int count = 0, unsigned int successful = 0) {
+        if (!enabled(level)) return false;
+
+        LogEvent event;
+        event.type = type;
+        event.level = level;
+        event.flags = flags;
+        event.account = account;
+        event.to = to;
+        event.count = count;
+        event.successful = successful;
+        event.amount = amount.cents();
+
+        return post(event);
+    }
+
+    // queue a record
+    // * returns false if the ring buffer is full
+    bool post(const LogEvent &event) {
+        unsigned long long pos = tail_.load(memory_order_relaxed);
+        LogCell *cell;
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            long long diff = (long long)cell->sequence.load(memory_order_acquire) - (long long)pos;
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos+1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, memory_order_relaxed);
+                return false;
+            } else {
+                pos = tail_.load(memory_order_relaxed);
+            }
+        }
+
+        cell->event = event;
+        cell->sequence.store(pos+1, memory_order_release);
+
+        return true;
+    }
+
+    // wait until all events queued so far are written
+    void flush() {
+        unsigned long long pos = tail_.load();
+
+        unique_lock<mutex> guard(lock_);
+        wake_.notify_one();
+        while (written_ < pos) flushed_.wait(guard);
+    }
+
+    // return the number of events dropped because the ring buffer was full
+    unsigned long long dropped() const {
+        return dropped_.load(memory_order_relaxed);
+    }
+
+    // format a record as one line of text
+    static void format(ostream &out, const LogEvent &event) {
+        Money amount = Money::from_cents(event.amount);
+
+        switch (event.type) {
+            case EVENT_ACCOUNT_OPENED:
+                out << "Account (nr: "<< event.account <<") created with a balance of EUR: "<< amount;
+                break;
+            case EVENT_ACCOUNT_TAKEN:
+                out << "# open failed: account number "<< event.account <<" is already taken";
+                break;
+            case EVENT_ACCOUNT_CLOSED:
+                out << "Account closed.";
+                break;
+            case EVENT_INVALID_DEPOSIT:
+                out << "Operation invalid: Please enter an amount greater than nothing.";
+                break;
+            case EVENT_INVALID_WITHDRAW:
+                out << "Operation invalid: We appreciate your donation very much, "
+                    << "unfortunately we are not allowed to accept it in this way.";
+                break;
+            case EVENT_DEPOSIT_FAILED:
+                out << "# deposit failed: no matching account = " << event.account;
+                break;
+            case EVENT_WITHDRAW_FAILED:
+                out << "# withdraw failed: no matching account = " << event.account << " with the given passwd";
+                break;
+            case EVENT_BALANCE_FAILED:
+                out << "# balance failed: no matching account = " << event.account << " with the given passwd";
+                break;
+            case EVENT_TRANSFER_DECLINED:
+                out << "# transfer declined: amount: "<< amount <<"; from "<< event.account <<" -> to "<< event.to;
+                break;
+            case EVENT_TRANSFERED:
+                out << "# transfered amount: "<< amount <<"; from "<< event.account <<" -> to "<< event.to <<" successfully";
+                break;
+            case EVENT_TRANSFER_FAILED:
+                out << "# transfer failed: matching from->to correct= "<< ((event.flags & EVENT_ACCOUNTS_FOUND) != 0)
+                    <<", pass correct= "<< ((event.flags & EVENT_PASSWD_CORRECT) != 0);
+                break;
+            case EVENT_BATCH_TRANSFERED:
+                out << "# transfered batch: "<< event.successful <<" of "<< event.count <<" transfers successful";
+                break;
+            default:
+                out << "# unknown event " << (int)event.type;
+        }
+    }
+
+protected:
+
+    // cell of the ring buffer
+    // * the sequence tells whether the cell is free for position "sequence"
+    //   or holds the record of position "sequence-1"
+    struct LogCell
+    {
+        LogCell() : sequence(0) {}
+        LogCell(const LogCell &) : sequence(0) {}
+
+        atomic<unsigned long long> sequence;
+        LogEvent event;
+    };
+
+    // take the next record
+    // * only called from the consumer
+    bool take(LogEvent *event) {
+        LogCell *cell = &cells_[head_ & mask_];
+
+        if (cell->sequence.load(memory_order_acquire) != head_+1) return false;
+
+        *event = cell->event;
+        cell->sequence.store(head_+mask_+1, memory_order_release);
+        head_++;
+
+        return true;
+    }
+
+    // background consumer
+    // * writes all available records, then waits for a flush request or a timeout of 10ms
+    void consume_loop() {
+        LogEvent event;
+
+        for (;;) {
+            bool written = false;
+
+            while (take(&event)) {
+                format(*out_, event);
+                *out_ << '\n';
+                written = true;
+            }
+
+            if (written) out_->flush();
+
+            unique_lock<mutex> guard(lock_);
+
+            written_ = head_;
+            flushed_.notify_all();
+
+            if (stop_ && head_ == tail_.load()) break;
+
+            wake_.wait_for(guard, chrono::milliseconds(stop_ ? 0 : 10));
+        }
+    }
+
+    ostream *out_;
+    atomic<int> level_;
+
+    vector<LogCell> cells_;
+    unsigned long long mask_;
+
+    unsigned long long head_;            // next position to consume
+    atomic<unsigned long long> tail_;    // next position to produce
+    unsigned long long written_;         // position up to which all records are written
+    atomic<unsigned long long> dropped_;
+
+    mutex lock_;
+    condition_variable wake_, flushed_;
+    bool stop_;
+
+    thread consumer_;
+};
+
+// event log of the bank
+// * writes to the console
+inline EventLog &event_log() {
+    static EventLog log;
+    return log;
+}
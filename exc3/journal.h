@@ -0,0 +1,567 @@
+#pragma once
+
+#include "cccbank.h"
+#include "checking.h"
+#include "digest.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace std;
+
+// journal record types
+enum JournalOp
+{
+    JOURNAL_OPEN = 1,
+    JOURNAL_DEPOSIT = 2,
+    JOURNAL_WITHDRAW = 3,
+    JOURNAL_TRANSFER = 4
+};
+
+// journal record of one bank mutation
+// * binary layout: op (1 byte), checking (1 byte), digest length (2 bytes),
+//   account (4 bytes), to (4 bytes), amount in cents (8 bytes), giro in cents (8 bytes),
+//   password digest (32 bytes, only for opened accounts)
+// * only the digest of the password is journaled, never the password itself
+struct JournalRecord
+{
+    JournalRecord()
+        : op(0), checking(false), account(0), to(0), amount(), giro() {}
+
+    unsigned char op;
+    bool checking; // account type of an opened account
+    int account;
+    int to;        // target account of a transfer
+    Money amount;
+    Money giro;    // giro limit of an opened checking account
+    PasswordDigest digest; // password digest of an opened account
+};
+
+// append-only binary journal with group commit
+// * records are collected in memory and written by a background flusher
+// * the flusher syncs the file once per group of records
+// * at most "group" records are not yet written, appending more blocks until the next flush
+// * a failed write or sync marks the journal as failed,
+//   no record is reported as durable after that and further appends are refused
+// * an existing journal is continued, its records keep their sequence numbers
+//   and a truncated record at its end is cut off
+class Journal
+{
+public:
+
+    Journal(const string &filename, unsigned int group = 64)
+        : group_(group>0?group:1), failed_(false), pending_(0), appended_(0), durable_(0), syncs_(0), sync_(false), stop_(false) {
+        fd_ = open(filename.c_str(), O_WRONLY|O_CREAT|O_APPEND, 0644);
+
+        if (fd_ >= 0 && !resume(filename)) {
+            close(fd_);
+            fd_ = -1;
+        }
+
+        if (fd_ >= 0) flusher_ = thread(&Journal::flush_loop, this);
+    }
+
+    // flush all pending records and close the journal
+    ~Journal() {
+        if (fd_ < 0) return;
+
+        {
+            lock_guard<mutex> guard(lock_);
+            stop_ = true;
+        }
+        flush_cond_.notify_one();
+        flusher_.join();
+
+        close(fd_);
+    }
+
+    // return true if the journal file could be opened and no write or sync has failed
+    bool good() const {
+        return fd_ >= 0 && !failed_;
+    }
+
+    // append a record
+    // * returns the sequence number of the record
+    // * returns 0 without appending if the journal is not good
+    unsigned long long append(const JournalRecord &record) {
+        unique_lock<mutex> guard(lock_);
+
+        while (pending_ >= group_ && good()) space_cond_.wait(guard);
+
+        if (!good()) return 0;
+
+        serialize(record, &buffer_);
+        pending_++;
+
+        if (pending_ >= group_) flush_cond_.notify_one();
+
+        return ++appended_;
+    }
+
+    // wait until the record with the given sequence number is durable
+    // * returns false if the record will never become durable, because the journal failed
+    bool sync(unsigned long long seq) {
+        if (fd_ < 0) return false;
+
+        unique_lock<mutex> guard(lock_);
+
+        if (durable_ >= seq) return true;
+
+        sync_ = true;
+        flush_cond_.notify_one();
+
+        while (durable_ < seq && good()) durable_cond_.wait(guard);
+
+        return durable_ >= seq;
+    }
+
+    // wait until all appended records are durable
+    // * returns false if the journal failed
+    bool sync() {
+        unsigned long long seq;
+
+        {
+            lock_guard<mutex> guard(lock_);
+            seq = appended_;
+        }
+
+        return sync(seq);
+    }
+
+    // return the number of durable records
+    unsigned long long durable() {
+        lock_guard<mutex> guard(lock_);
+        return durable_;
+    }
+
+    // return the number of group commits that made the records durable
+    // * the number of durable records per sync shows how full the groups actually were
+    unsigned long long syncs() {
+        lock_guard<mutex> guard(lock_);
+        return syncs_;
+    }
+
+    // replay a journal into a fresh bank
+    // * accounts are re-created as plain or checking accounts with their password digests
+    // * the journal only holds authorized operations,
+    //   so withdrawals and transfers are applied without authentication
+    // * the records up to sequence number "after" are skipped,
+    //   so a bank restored from a snapshot at that position only replays the newer records
+    // * a truncated record at the end of the journal is ignored
+    // * returns the number of replayed records
+    //   or -1 if the journal could not be read or ends before the given position
+    static long long replay(const string &filename, CCCBank &bank, unsigned long long after = 0) {
+        vector<char> data;
+
+        if (!read_file(filename, &data)) return -1;
+        if (data.size() < 8 || memcmp(&data[0], magic(), 8) != 0) return -1;
+
+        long long count = 0;
+        unsigned long long seq = 0;
+        size_t pos = 8;
+
+        JournalRecord record;
+
+        while (deserialize(data, &pos, &record)) {
+            if (++seq <= after) continue;
+
+            switch (record.op) {
+                case JOURNAL_OPEN: {
+                    Account *a = record.checking ? new CheckingAccount(record.giro) : new Account();
+                    if (record.amount > Money()) a->deposit(record.amount);
+                    if (!bank.restore_account(record.account, record.digest, a)) delete a;
+                    break;
+                }
+                case JOURNAL_DEPOSIT:
+                    bank.deposit(record.account, record.amount);
+                    break;
+                case JOURNAL_WITHDRAW:
+                    bank.restore_withdraw(record.account, record.amount);
+                    break;
+                case JOURNAL_TRANSFER:
+                    bank.restore_transfer(record.account, record.to, record.amount);
+                    break;
+                default:
+                    return -1;
+            }
+
+            count++;
+        }
+
+        if (seq < after) return -1;
+
+        return count;
+    }
+
+protected:
+
+    static const char *magic() {
+        return "CCCJRN3\n";
+    }
+
+    static const size_t header_size = 28;
+
+    // read an entire file
+    static bool read_file(const string &filename, vector<char> *data) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        char block[65536];
+        ssize_t bytes;
+
+        data->clear();
+
+        while ((bytes = read(fd, block, sizeof(block))) > 0)
+            data->insert(data->end(), block, block+bytes);
+
+        close(fd);
+
+        return bytes == 0;
+    }
+
+    // prepare the opened journal file for appending
+    // * a new file gets the magic, an existing one must start with it
+    // * the records of an existing file are counted, so the sequence numbers continue
+    // * returns false if the file could not be prepared
+    bool resume(const string &filename) {
+        vector<char> data;
+
+        if (!read_file(filename, &data)) return false;
+
+        if (data.empty()) return write(fd_, magic(), 8) == 8;
+
+        if (data.size() < 8 || memcmp(&data[0], magic(), 8) != 0) return false;
+
+        size_t pos = 8;
+        JournalRecord record;
+
+        while (deserialize(data, &pos, &record)) appended_++;
+
+        durable_ = appended_;
+
+        // cut off a truncated record, so new records follow the last complete one
+        return pos == data.size() || ftruncate(fd_, pos) == 0;
+    }
+
+    // append the binary representation of a record to a buffer
+    static void serialize(const JournalRecord &record, vector<char> *buffer) {
+        size_t pos = buffer->size();
+        unsigned short length = (record.op == JOURNAL_OPEN) ? PasswordDigest::size : 0;
+
+        buffer->resize(pos+header_size+length);
+        char *ptr = &(*buffer)[pos];
+
+        ptr[0] = record.op;
+        ptr[1] = record.checking;
+        memcpy(ptr+2, &length, 2);
+        memcpy(ptr+4, &record.account, 4);
+        memcpy(ptr+8, &record.to, 4);
+        long long amount = record.amount.cents();
+        long long giro = record.giro.cents();
+
+        memcpy(ptr+12, &amount, 8);
+        memcpy(ptr+20, &giro, 8);
+        memcpy(ptr+header_size, record.digest.bytes(), length);
+    }
+
+    // read the record at position "pos" and advance the position
+    // * returns false if no complete record is left
+    static bool deserialize(const vector<char> &data, size_t *pos, JournalRecord *record) {
+        if (*pos+header_size > data.size()) return false;
+
+        const char *ptr = &data[*pos];
+        unsigned short length;
+
+        memcpy(&length, ptr+2, 2);
+        if (length != 0 && length != PasswordDigest::size) return false;
+        if (*pos+header_size+length > data.size()) return false;
+
+        record->op = ptr[0];
+        record->checking = ptr[1];
+        memcpy(&record->account, ptr+4, 4);
+        memcpy(&record->to, ptr+8, 4);
+        long long amount, giro;
+
+        memcpy(&amount, ptr+12, 8);
+        memcpy(&giro, ptr+20, 8);
+
+        record->amount = Money::from_cents(amount);
+        record->giro = Money::from_cents(giro);
+        record->digest = length ? PasswordDigest::from_bytes((const unsigned char *)ptr+header_size) : PasswordDigest();
+
+        *pos += header_size+length;
+
+        return true;
+    }
+
+    // write a buffer completely
+    // * interrupted writes are retried
+    // * returns false if the buffer could not be written
+    bool write_all(const vector<char> &buffer) {
+        size_t written = 0;
+
+        while (written < buffer.size()) {
+            ssize_t bytes = write(fd_, &buffer[written], buffer.size()-written);
+            if (bytes < 0 && errno == EINTR) continue;
+            if (bytes <= 0) return false;
+            written += bytes;
+        }
+
+        return true;
+    }
+
+    // background flusher
+    // * waits for a full group, a sync request or a timeout of 10ms
+    // * writes the collected records with a single sync
+    // * once the journal failed, the collected records are dropped
+    void flush_loop() {
+        vector<char> buffer;
+
+        unique_lock<mutex> guard(lock_);
+
+        for (;;) {
+            while (pending_ < group_ && !sync_ && !stop_)
+                if (flush_cond_.wait_for(guard, chrono::milliseconds(10)) == cv_status::timeout) break;
+
+            if (pending_ > 0) {
+                unsigned long long seq = appended_;
+
+                buffer.swap(buffer_);
+                pending_ = 0;
+                sync_ = false;
+                space_cond_.notify_all();
+
+                bool ok = !failed_;
+
+                guard.unlock();
+
+                if (ok) ok = write_all(buffer) && fdatasync(fd_) == 0;
+                buffer.clear();
+
+                guard.lock();
+
+                if (ok) {
+                    durable_ = seq;
+                    syncs_++;
+                } else if (!failed_) {
+                    failed_ = true;
+                    space_cond_.notify_all();
+                }
+
+                durable_cond_.notify_all();
+            } else {
+                sync_ = false;
+            }
+
+            if (stop_ && pending_ == 0) break;
+        }
+    }
+
+    int fd_;
+    unsigned int group_;
+
+    mutex lock_;
+    condition_variable flush_cond_, space_cond_, durable_cond_;
+
+    atomic<bool> failed_; // set by the flusher when a write or sync failed
+
+    vector<char> buffer_;
+    unsigned int pending_;
+    unsigned long long appended_, durable_;
+    unsigned long long syncs_;
+    bool sync_, stop_;
+
+    thread flusher_;
+};
+
+// total bank balance at a journal position
+struct BalanceSnapshot
+{
+    unsigned long long position; // sequence number of the last journaled record
+    Money total;                 // total bank balance after applying that record
+};
+
+// journaled bank
+// * forwards all operations to another bank
+// * successful mutations are appended to the journal in the order they were applied,
+//   so a replay takes the same decisions as the original run
+// * by default a mutation is only acknowledged when its record is durable,
+//   the wait for the sync is outside of the bank lock, so concurrent mutations share a group commit
+// * without waiting a mutation is acknowledged once its record is appended,
+//   it becomes durable with the next group commit and Journal::sync() waits for it
+// * no mutation is applied once the journal failed,
+//   a deposit, withdrawal or transfer that was applied but could not be made durable reports failure
+//   and stays applied in memory
+// * an opened account is owned by the bank as soon as the other bank accepted it,
+//   so opening reports success then and a durability failure only shows in Journal::good()
+// * the total bank balance is maintained together with the journal position
+class JournalBank: public Bank
+{
+public:
+
+    JournalBank(Bank *bank, Journal *journal, bool wait = true)
+        : Bank(), bank_(bank), journal_(journal), wait_(wait) {
+        snapshot_.position = journal->durable();
+        snapshot_.total = bank->total_balance();
+    }
+
+    ~JournalBank() {}
+
+    bool open_account(int account_nr, string_view passwd, Account *a) {
+        unsigned long long seq;
+
+        JournalRecord record;
+        CheckingAccount *checking = dynamic_cast<CheckingAccount *>(a);
+
+        // the account is described before it is handed over to the other bank
+        record.op = JOURNAL_OPEN;
+        record.checking = (checking != NULL);
+        record.account = account_nr;
+        record.amount = a->balance();
+        record.giro = checking ? checking->get_giro() : Money();
+        record.digest = PasswordDigest::of(account_nr, passwd);
+
+        {
+            lock_guard<mutex> guard(lock_);
+
+            if (!journal_->good()) return false;
+            if (!bank_->open_account(account_nr, passwd, a)) return false;
+
+            seq = journal_->append(record);
+            if (seq != 0) publish(seq, record.amount);
+        }
+
+        // the other bank owns the account now, so it must not be left to the caller
+        durable(seq);
+
+        return true;
+    }
+
+    bool deposit(int account_nr, Money amount) {
+        unsigned long long seq;
+
+        {
+            lock_guard<mutex> guard(lock_);
+
+            if (!journal_->good()) return false;
+            if (!bank_->deposit(account_nr, amount)) return false;
+
+            JournalRecord record;
+
+            record.op = JOURNAL_DEPOSIT;
+            record.account = account_nr;
+            record.amount = amount;
+
+            seq = journal_->append(record);
+            if (seq != 0) publish(seq, amount);
+        }
+
+        return durable(seq);
+    }
+
+    bool withdraw(int account_nr, string_view passwd, Money amount) {
+        unsigned long long seq;
+
+        {
+            lock_guard<mutex> guard(lock_);
+
+            if (!journal_->good()) return false;
+            if (!bank_->withdraw(account_nr, passwd, amount)) return false;
+
+            JournalRecord record;
+
+            record.op = JOURNAL_WITHDRAW;
+            record.account = account_nr;
+            record.amount = amount;
+
+            seq = journal_->append(record);
+            if (seq != 0) publish(seq, -amount);
+        }
+
+        return durable(seq);
+    }
+
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        unsigned long long seq;
+
+        {
+            lock_guard<mutex> guard(lock_);
+
+            if (!journal_->good()) return false;
+            if (!bank_->transfer(from, to, passwd, amount)) return false;
+
+            JournalRecord record;
+
+            record.op = JOURNAL_TRANSFER;
+            record.account = from;
+            record.to = to;
+            record.amount = amount;
+
+            seq = journal_->append(record);
+            if (seq != 0) publish(seq, Money());
+        }
+
+        return durable(seq);
+    }
+
+    Money balance(int account_nr, string_view passwd) {
+        return bank_->balance(account_nr, passwd);
+    }
+
+    // return the total bank balance
+    // * which is maintained incrementally, so the other bank is not asked
+    Money total_balance() {
+        return balance_snapshot().total;
+    }
+
+    // return the total bank balance together with the journal position it belongs to
+    // * a replay of the journal up to that position yields exactly that total
+    BalanceSnapshot balance_snapshot() {
+        lock_guard<mutex> guard(snapshot_lock_);
+        return snapshot_;
+    }
+
+    // call f() while no mutation is applied
+    // * returns the journal position that the state seen by f() belongs to,
+    //   e.g. to take a snapshot of the other bank that the journal continues
+    template <class F>
+    unsigned long long quiesce(F f) {
+        lock_guard<mutex> guard(lock_);
+        f();
+        return balance_snapshot().position;
+    }
+
+protected:
+
+    // wait until the record of an applied mutation is durable
+    // * sequence number 0 means that the record could not be appended
+    // * without waiting an appended record is acknowledged right away
+    bool durable(unsigned long long seq) {
+        return seq != 0 && (!wait_ || journal_->sync(seq));
+    }
+
+    // advance the journal position and the total bank balance together
+    void publish(unsigned long long position, Money delta) {
+        lock_guard<mutex> guard(snapshot_lock_);
+        snapshot_.position = position;
+        snapshot_.total += delta;
+    }
+
+    Bank *bank_;
+    Journal *journal_;
+    bool wait_; // acknowledge mutations only when their records are durable
+
+    mutex lock_; // keeps the journal order equal to the order of application
+
+    mutex snapshot_lock_; // only held to read or publish the snapshot
+    BalanceSnapshot snapshot_;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "bank.h"
+
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// single lock around a non-concurrent bank
+// * makes CCCBank or PoolBank usable from several threads, e.g. as a baseline for ShardedBank
+template <class B>
+class LockedBank: public Bank
+{
+public:
+
+    LockedBank(unsigned int capacity = 16)
+        : Bank(), bank_(capacity) {}
+
+    bool open_account(int account, string_view passwd, Account *a) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.open_account(account, passwd, a);
+    }
+
+    bool deposit(int account, Money amount) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.deposit(account, amount);
+    }
+
+    bool withdraw(int account, string_view passwd, Money amount) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.withdraw(account, passwd, amount);
+    }
+
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.transfer(from, to, passwd, amount);
+    }
+
+    vector<bool> transfer_batch(const TransferRecord *records, unsigned int count) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.transfer_batch(records, count);
+    }
+
+    Money balance(int account, string_view passwd) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.balance(account, passwd);
+    }
+
+    Money total_balance() {
+        lock_guard<mutex> guard(lock_);
+        return bank_.total_balance();
+    }
+
+    bool read_version(int account, string_view passwd, Money *balance, unsigned long long *version) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.read_version(account, passwd, balance, version);
+    }
+
+    TransactionResult commit(const Transaction &tx) {
+        lock_guard<mutex> guard(lock_);
+        return bank_.commit(tx);
+    }
+
+    // call f(account_nr, protected_account) for all accounts
+    // * under the lock, so f sees the accounts at one consistent point in time
+    template <class F>
+    void for_each_account(F f) {
+        lock_guard<mutex> guard(lock_);
+        bank_.for_each_account(f);
+    }
+
+protected:
+
+    mutex lock_;
+    B bank_;
+};
@@ -4,8 +4,13 @@
 
 #include <iostream>
 
+#include <stdlib.h>
+
 int main(int argc, char *argv[])
 {
+   // optional log level: 0 = debug, 1 = info (default), 2 = warning, 3 = error, 4 = off
+   if (argc > 1) event_log().set_level((LogLevel)atoi(argv[1]));
+
    CCCBank ccc;
 
    ccc.open_account(42, "foo", new Account());
@@ -25,7 +30,8 @@ int main(int argc, char *argv[])
    for (int i=1; i<=100; i++)
       ccc.transfer((271*(i-1)+71)%100+1, i, "", i);
 
+   event_log().flush();
    std::cout << "total bank balance: " << ccc.total_balance() << std::endl;
 
-   return(ccc.total_balance());
+   return(ccc.total_balance().euro());
 }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+
+// exact amount of money in euro cents
+// * stored as a 64-bit integer, so sums and differences never drift
+// * converts implicitly from euro given as floating point, rounded to the nearest cent
+class Money
+{
+public:
+  Money() : cents_(0) {}
+  Money(double euro) : cents_(std::llround(euro*100)) {}
+
+  // construct from an amount in cents
+  static Money from_cents(long long cents) {
+    Money m;
+    m.cents_ = cents;
+    return m;
+  }
+
+  // Getter
+  long long cents() const { return cents_; }
+  double euro() const { return cents_/100.0; }
+
+  Money &operator+=(const Money &m) { cents_ += m.cents_; return *this; }
+  Money &operator-=(const Money &m) { cents_ -= m.cents_; return *this; }
+  Money operator-() const { return from_cents(-cents_); }
+
+private:
+  long long cents_;
+};
+
+inline Money operator+(const Money &a, const Money &b) { return Money::from_cents(a.cents()+b.cents()); }
+inline Money operator-(const Money &a, const Money &b) { return Money::from_cents(a.cents()-b.cents()); }
+
+inline bool operator==(const Money &a, const Money &b) { return a.cents() == b.cents(); }
+inline bool operator!=(const Money &a, const Money &b) { return a.cents() != b.cents(); }
+inline bool operator<(const Money &a, const Money &b) { return a.cents() < b.cents(); }
+inline bool operator<=(const Money &a, const Money &b) { return a.cents() <= b.cents(); }
+inline bool operator>(const Money &a, const Money &b) { return a.cents() > b.cents(); }
+inline bool operator>=(const Money &a, const Money &b) { return a.cents() >= b.cents(); }
+
+inline std::ostream &operator<<(std::ostream &out, const Money &m) { return out << m.euro(); }
+
+// apply an interest rate to "n" contiguous balances
+// * the rate is given in parts per million (e.g. 12500 for 1.25%), negative rates are allowed
+// * the interest of each balance is rounded to the nearest cent, halves away from zero
+// * the loops are branch-free over a contiguous array, so the compiler can vectorize them
+// * returns false and leaves all balances unchanged if any interest computation would overflow
+inline bool post_interest(Money *balances, size_t n, long long ppm) {
+  const long long scale = 1000000;
+  const long long limit = ppm == 0 ? 0x7fffffffffffffffLL : 0x7fffffffffffffffLL/(ppm < 0 ? -ppm : ppm)/2;
+
+  // overflow check pass
+  long long overflow = 0;
+  for (size_t i = 0; i < n; i++) {
+    long long c = balances[i].cents();
+    overflow |= (c > limit) | (c < -limit);
+  }
+  if (overflow) return false;
+
+  // posting pass
+  for (size_t i = 0; i < n; i++) {
+    long long c = balances[i].cents();
+    long long p = c*ppm;
+    long long half = p < 0 ? -scale/2 : scale/2;
+    balances[i] = Money::from_cents(c+(p+half)/scale);
+  }
+
+  return true;
+}
+
+// charge a fee on "n" contiguous balances
+// * a negative fee is a credit
+// * returns false and leaves all balances unchanged if any balance would overflow
+inline bool post_fee(Money *balances, size_t n, Money fee) {
+  const long long f = fee.cents();
+  const long long lower = f > 0 ? (-0x7fffffffffffffffLL-1)+f : -0x7fffffffffffffffLL-1;
+  const long long upper = f < 0 ? 0x7fffffffffffffffLL+f : 0x7fffffffffffffffLL;
+
+  // overflow check pass
+  long long overflow = 0;
+  for (size_t i = 0; i < n; i++) {
+    long long c = balances[i].cents();
+    overflow |= (c < lower) | (c > upper);
+  }
+  if (overflow) return false;
+
+  // posting pass
+  for (size_t i = 0; i < n; i++)
+    balances[i] = Money::from_cents(balances[i].cents()-f);
+
+  return true;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "bank.h"
+#include "accountindex.h"
+#include "checking.h"
+#include "digest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// account types of the pool
+enum PoolType
+{
+    POOL_ACCOUNT = 0,
+    POOL_CHECKING = 1
+};
+
+// pooled CCC-Bank
+// * the accounts live in contiguous arrays (one per attribute) instead of separate heap objects
+// * each account carries a type tag, so the withdrawal rules are selected without virtual calls
+// * the account index maps the account number to the position in the pool
+class PoolBank: public Bank
+{
+public:
+
+    PoolBank(unsigned int capacity = 16)
+        : Bank(), index_(capacity) {
+        balances_.reserve(capacity);
+        giros_.reserve(capacity);
+        types_.reserve(capacity);
+        digests_.reserve(capacity);
+    }
+
+    ~PoolBank() {}
+
+    // open account
+    // * with account number "account",
+    // * password "passwd"
+    // * and a reference "a" to a new account
+    // * the type, giro limit and balance are copied into the pool and "a" is deleted
+    // * if the account number was already taken, "a" is left to the caller like in the other banks
+    // * returns true if the account number was not already taken
+    bool open_account(int account_nr, string_view passwd, Account *a) {
+        CheckingAccount *checking = dynamic_cast<CheckingAccount *>(a);
+
+        bool created = open_account(account_nr, passwd,
+                                    checking ? POOL_CHECKING : POOL_ACCOUNT,
+                                    checking ? checking->get_giro() : Money(),
+                                    a->balance());
+        if (created) delete a;
+
+        return created;
+    }
+
+    // open account directly in the pool
+    // * with account number "account",
+    // * password "passwd",
+    // * account type "type", giro limit "giro" and initial balance "balance"
+    // * returns true if the account number was not already taken
+    bool open_account(int account_nr, string_view passwd, PoolType type, Money giro = Money(), Money balance = Money()) {
+        if (!index_.insert(account_nr, balances_.size()).second) return false;
+
+        balances_.push_back(balance);
+        giros_.push_back(type == POOL_CHECKING ? giro : Money());
+        types_.push_back(type);
+        digests_.push_back(PasswordDigest::of(account_nr, passwd));
+
+        return true;
+    }
+
+    // deposit amount on account
+    // * if account is existing
+    // * returns true if the deposit was successful
+    bool deposit(int account_nr, Money amount) {
+        unsigned int *slot = index_.find(account_nr);
+        if (slot == NULL || amount <= Money()) return false;
+
+        balances_[*slot] += amount;
+
+        return true;
+    }
+
+    // withdraw amount from account
+    // * if account is existing
+    // * and if passwd matches the account password
+    // * returns true if the withdrawal was successful
+    bool withdraw(int account_nr, string_view passwd, Money amount) {
+        unsigned int *slot = index_.find(account_nr);
+        if (slot == NULL || !CredentialCache::verify(account_nr, digests_[*slot], passwd)) return false;
+
+        return withdraw_slot(*slot, amount);
+    }
+
+    // transfer amount from one account to another one
+    // * if both accounts are existing
+    // * and if passwd matches the account password
+    // * and if the withdrawal was successful
+    // * returns true if the transfer was successful
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        unsigned int *slot_from = index_.find(from);
+        unsigned int *slot_to = index_.find(to);
+
+        if (slot_from == NULL || slot_to == NULL) return false;
+        if (!CredentialCache::verify(from, digests_[*slot_from], passwd)) return false;
+
+        if (!withdraw_slot(*slot_from, amount)) return false;
+        if (amount > Money()) balances_[*slot_to] += amount;
+
+        return true;
+    }
+
+    // return the account balance
+    // * if account is existing
+    // * and if passwd matches the account password
+    Money balance(int account_nr, string_view passwd) {
+        unsigned int *slot = index_.find(account_nr);
+        if (slot == NULL || !CredentialCache::verify(account_nr, digests_[*slot], passwd)) return Money();
+
+        return balances_[*slot];
+    }
+
+    // return the total bank balance
+    // * which is the sum of all account balances
+    // * a linear scan over the contiguous balances, which the compiler can vectorize
+    Money total_balance() {
+        const Money *balances = balances_.data();
+        size_t n = balances_.size();
+
+        long long total = 0;
+
+        for (size_t i = 0; i < n; i++) total += balances[i].cents();
+
+        return Money::from_cents(total);
+    }
+
+    // credit interest on all accounts
+    // * the rate is given in parts per million, negative rates debit interest
+    // * returns false and changes no balance if a balance would overflow
+    bool post_interest(long long ppm) {
+        return ::post_interest(balances_.data(), balances_.size(), ppm);
+    }
+
+    // charge a fee on all accounts
+    // * the fee is charged regardless of the withdrawal rules
+    // * returns false and changes no balance if a balance would overflow
+    bool post_fee(Money fee) {
+        return ::post_fee(balances_.data(), balances_.size(), fee);
+    }
+
+protected:
+
+    // withdraw from the account at a pool position
+    // * applies the rules of Account::withdraw or CheckingAccount::withdraw depending on the type tag
+    bool withdraw_slot(unsigned int slot, Money euro) {
+        if (euro < Money()) return false;
+
+        Money &balance = balances_[slot];
+
+        switch (types_[slot]) {
+            case POOL_CHECKING:
+                if ((balance + giros_[slot] - euro) >= 0) {
+                    balance -= euro;
+                    return true;
+                }
+                return false;
+            default:
+                if (balance >= euro) {
+                    balance -= euro;
+                    return true;
+                }
+                return false;
+        }
+    }
+
+    AccountIndex<unsigned int> index_;
+
+    vector<Money> balances_;
+    vector<Money> giros_;
+    vector<unsigned char> types_;
+    vector<PasswordDigest> digests_;
+};
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "cccbank.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// accounts of one shard guarded by a common lock
+class AccountShard
+{
+public:
+
+    AccountShard() : total() {}
+
+    mutex lock; // public -> no getter required
+    AccountIndex<ProtectedAccount> accounts; // public -> no getter required
+    Money total; // sum of the account balances of the shard
+};
+
+// deposit slot of a hot account
+// * padded to a full cache line, so threads depositing into different slots do not share a line
+struct HotSlot
+{
+    HotSlot() : cents(0) {}
+
+    atomic<long long> cents;
+    char padding[64-sizeof(atomic<long long>)];
+};
+
+// account that receives most of the deposits
+// * each thread credits its own slot without locking
+// * the slots are collected into the real balance when the account is read or withdrawn from
+class HotAccount
+{
+public:
+
+    static const unsigned int slots = 64;
+
+    HotAccount(int account_nr) : account(account_nr) {}
+
+    // credit an amount in the slot of the calling thread
+    void credit(Money amount) {
+        slot[thread_slot()].cents.fetch_add(amount.cents(), memory_order_relaxed);
+    }
+
+    // collect and reset the credits of all slots
+    Money collect() {
+        long long sum = 0;
+        for (unsigned int i = 0; i < slots; i++)
+            sum += slot[i].cents.exchange(0, memory_order_acq_rel);
+        return Money::from_cents(sum);
+    }
+
+    int account; // public -> no getter required
+
+protected:
+
+    // slot of the calling thread, assigned round-robin on first use
+    static unsigned int thread_slot() {
+        static atomic<unsigned int> next(0);
+        static thread_local unsigned int index = next++ % slots;
+        return index;
+    }
+
+    HotSlot slot[slots];
+};
+
+// concurrent CCC-Bank
+// * the accounts are distributed over a fixed number of shards
+// * each shard has its own lock, so operations on different shards run in parallel
+// * a transfer locks both shards in ascending shard order, so it cannot deadlock
+// * each shard maintains the partial sum of its balances,
+//   so updates on different shards do not contend on a common counter
+// * deposits on accounts marked as hot bypass the shard lock
+class ShardedBank: public Bank
+{
+public:
+
+    ShardedBank(unsigned int shards = 64)
+        : Bank(), shards_(shards>0?shards:1), hot_(NULL) {}
+
+    ~ShardedBank() {
+        for (unsigned int i = 0; i < hot_accounts_.size(); i++) delete hot_accounts_[i];
+        for (unsigned int i = 0; i < hot_tables_.size(); i++) delete hot_tables_[i];
+    }
+
+    // open account
+    // * with account number "account",
+    // * password "passwd"
+    // * and a reference "a" to a new account
+    // * returns true if the account number was not already taken
+    bool open_account(int account_nr, string_view passwd, Account *a) {
+        AccountShard &shard = shards_[shard_index(account_nr)];
+        lock_guard<mutex> guard(shard.lock);
+
+        if (!shard.accounts.insert(account_nr, ProtectedAccount(a, PasswordDigest::of(account_nr, passwd))).second) return false;
+        shard.total += a->balance();
+
+        return true;
+    }
+
+    // mark an account as hot
+    // * deposits on a hot account are credited lock-free in per-thread slots
+    // * returns true if the account is existing
+    bool mark_hot(int account_nr) {
+        lock_guard<mutex> guard(hot_lock_);
+
+        {
+            AccountShard &shard = shards_[shard_index(account_nr)];
+            lock_guard<mutex> guard(shard.lock);
+            if (shard.accounts.find(account_nr) == NULL) return false;
+        }
+
+        if (find_hot(account_nr) != NULL) return true;
+
+        // publish a new table, the old one stays valid for concurrent readers
+        const vector<HotAccount *> *table = hot_.load();
+        vector<HotAccount *> *new_table = table ? new vector<HotAccount *>(*table) : new vector<HotAccount *>;
+
+        hot_accounts_.push_back(new HotAccount(account_nr));
+        new_table->push_back(hot_accounts_.back());
+        hot_tables_.push_back(new_table);
+
+        hot_.store(new_table, memory_order_release);
+
+        return true;
+    }
+
+    // deposit amount on account
+    // * if account is existing
+    // * returns true if the deposit was successful
+    bool deposit(int account_nr, Money amount) {
+        HotAccount *hot = find_hot(account_nr);
+        if (hot != NULL) {
+            if (amount <= Money()) return false;
+            hot->credit(amount);
+            return true;
+        }
+
+        AccountShard &shard = shards_[shard_index(account_nr)];
+        lock_guard<mutex> guard(shard.lock);
+
+        ProtectedAccount *it = shard.accounts.find(account_nr);
+        if (it == NULL || !it->account->deposit(amount)) return false;
+        it->version++;
+        shard.total += amount;
+
+        return true;
+    }
+
+    // withdraw amount from account
+    // * if account is existing
+    // * and if passwd matches the account password
+    // * returns true if the withdrawal was successful
+    bool withdraw(int account_nr, string_view passwd, Money amount) {
+        AccountShard &shard = shards_[shard_index(account_nr)];
+        lock_guard<mutex> guard(shard.lock);
+
+        ProtectedAccount *it = shard.accounts.find(account_nr);
+        if (it == NULL || !it->verify(account_nr, passwd)) return false;
+
+        fold_hot(shard, account_nr, it);
+
+        if (!it->account->withdraw(amount)) return false;
+        it->version++;
+        shard.total -= amount;
+
+        return true;
+    }
+
+    // transfer amount from one account to another one
+    // * if both accounts are existing
+    // * and if passwd matches the account password
+    // * and if the withdrawal was successful
+    // * returns true if the transfer was successful
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        unsigned int i = shard_index(from);
+        unsigned int j = shard_index(to);
+
+        if (i == j) {
+            lock_guard<mutex> guard(shards_[i].lock);
+            return transfer_locked(from, to, passwd, amount);
+        }
+
+        // always lock the lower shard first
+        lock_guard<mutex> guard1(shards_[min(i, j)].lock);
+        lock_guard<mutex> guard2(shards_[max(i, j)].lock);
+        return transfer_locked(from, to, passwd, amount);
+    }
+
+    // return the account balance
+    // * if account is existing
+    // * and if passwd matches the account password
+    Money balance(int account_nr, string_view passwd) {
+        AccountShard &shard = shards_[shard_index(account_nr)];
+        lock_guard<mutex> guard(shard.lock);
+
+        ProtectedAccount *it = shard.accounts.find(account_nr);
+        if (it != NULL && it->verify(account_nr, passwd)) {
+            fold_hot(shard, account_nr, it);
+            return it->account->balance();
+        }
+
+        return 0;
+    }
+
+    // return the total bank balance
+    // * which is the sum of all account balances
+    // * adds up the partial sums of the shards
+    // * all shards are locked in ascending order to get a consistent sum
+    Money total_balance() {
+        Money total;
+
+        for (unsigned int i = 0; i < shards_.size(); i++) shards_[i].lock.lock();
+
+        fold_all_hot();
+
+        for (unsigned int i = 0; i < shards_.size(); i++) total += shards_[i].total;
+
+        for (unsigned int i = shards_.size(); i > 0; i--) shards_[i-1].lock.unlock();
+
+        return total;
+    }
+
+    // call f(account_nr, protected_account) for all accounts
+    // * all shards are locked during the iteration,
+    //   so f sees the accounts at one consistent point in time
+    template <class F>
+    void for_each_account(F f) {
+        for (unsigned int i = 0; i < shards_.size(); i++) shards_[i].lock.lock();
+
+        fold_all_hot();
+
+        for (unsigned int i = 0; i < shards_.size(); i++)
+            shards_[i].accounts.for_each(f);
+
+        for (unsigned int i = shards_.size(); i > 0; i--) shards_[i-1].lock.unlock();
+    }
+
+    // read the balance and the version of an account for a transaction
+    // * if account is existing
+    // * and if passwd matches the account password
+    // * the pending credits of a hot account are folded without changing the version
+    bool read_version(int account_nr, string_view passwd, Money *balance, unsigned long long *version) {
+        AccountShard &shard = shards_[shard_index(account_nr)];
+        lock_guard<mutex> guard(shard.lock);
+
+        ProtectedAccount *it = shard.accounts.find(account_nr);
+        if (it == NULL || !it->verify(account_nr, passwd)) return false;
+
+        fold_hot(shard, account_nr, it);
+
+        *balance = it->account->balance();
+        *version = it->version;
+
+        return true;
+    }
+
+    // validate and apply a transaction atomically
+    // * the shards of all accounts of the transaction are locked in ascending order,
+    //   so no reader sees a partially applied transaction
+    // * lock-free deposits on hot accounts do not change the version of the account
+    TransactionResult commit(const Transaction &tx) {
+        vector<unsigned int> locked;
+
+        for (size_t i = 0; i < tx.reads().size(); i++) locked.push_back(shard_index(tx.reads()[i].account));
+        for (size_t i = 0; i < tx.writes().size(); i++) locked.push_back(shard_index(tx.writes()[i].account));
+
+        sort(locked.begin(), locked.end());
+        locked.erase(unique(locked.begin(), locked.end()), locked.end());
+
+        for (size_t i = 0; i < locked.size(); i++) shards_[locked[i]].lock.lock();
+
+        for (size_t i = 0; i < tx.writes().size(); i++) {
+            const TransactionWrite &write = tx.writes()[i];
+            AccountShard &shard = shards_[shard_index(write.account)];
+            ProtectedAccount *it = shard.accounts.find(write.account);
+            if (write.withdraw && it != NULL) fold_hot(shard, write.account, it);
+        }
+
+        TransactionResult result = apply_transaction(tx,
+            [this](int account_nr) { return shards_[shard_index(account_nr)].accounts.find(account_nr); },
+            [this](int account_nr, Money amount) { shards_[shard_index(account_nr)].total += amount; });
+
+        for (size_t i = locked.size(); i > 0; i--) shards_[locked[i-1]].lock.unlock();
+
+        return result;
+    }
+
+    // return the number of shards
+    unsigned int shards() const {
+        return shards_.size();
+    }
+
+protected:
+
+    // map an account number to its shard
+    unsigned int shard_index(int account_nr) const {
+        return ((unsigned int)account_nr * 2654435761u) % shards_.size();
+    }
+
+    // transfer with the shards of both accounts being locked
+    bool transfer_locked(int from, int to, string_view passwd, Money amount) {
+        AccountShard &shard_from = shards_[shard_index(from)];
+        AccountShard &shard_to = shards_[shard_index(to)];
+
+        ProtectedAccount *it_from = shard_from.accounts.find(from);
+        ProtectedAccount *it_to = shard_to.accounts.find(to);
+
+        if (it_from == NULL || it_to == NULL) return false;
+        if (!it_from->verify(from, passwd)) return false;
+
+        fold_hot(shard_from, from, it_from);
+
+        if (!it_from->account->withdraw(amount)) return false;
+        it_to->account->deposit(amount);
+        it_from->version++;
+        it_to->version++;
+
+        shard_from.total -= amount;
+        shard_to.total += amount;
+
+        return true;
+    }
+
+    // return the hot account with the given number or NULL
+    // * lock-free, the published table is never modified
+    HotAccount *find_hot(int account_nr) const {
+        const vector<HotAccount *> *table = hot_.load(memory_order_acquire);
+        if (table == NULL) return NULL;
+
+        for (unsigned int i = 0; i < table->size(); i++)
+            if ((*table)[i]->account == account_nr) return (*table)[i];
+
+        return NULL;
+    }
+
+    // fold the pending credits of a hot account into its balance
+    // * with the shard of the account being locked
+    // * the version is left unchanged, since the pending credits were already part of the balance,
+    //   so lock-free deposits do not make transactions on a hot account conflict
+    void fold_hot(AccountShard &shard, int account_nr, ProtectedAccount *it) {
+        HotAccount *hot = find_hot(account_nr);
+        if (hot == NULL) return;
+
+        Money credits = hot->collect();
+        if (credits > Money() && it->account->deposit(credits)) shard.total += credits;
+    }
+
+    // fold the pending credits of all hot accounts
+    // * with all shards being locked
+    void fold_all_hot() {
+        const vector<HotAccount *> *table = hot_.load(memory_order_acquire);
+        if (table == NULL) return;
+
+        for (unsigned int i = 0; i < table->size(); i++) {
+            int account_nr = (*table)[i]->account;
+            AccountShard &shard = shards_[shard_index(account_nr)];
+            fold_hot(shard, account_nr, shard.accounts.find(account_nr));
+        }
+    }
+
+    vector<AccountShard> shards_;
+
+    atomic<const vector<HotAccount *> *> hot_; // published table of hot accounts
+    mutex hot_lock_;                           // serializes marking accounts as hot
+    vector<HotAccount *> hot_accounts_;
+    vector<const vector<HotAccount *> *> hot_tables_;
+};
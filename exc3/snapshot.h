@@ -0,0 +1,335 @@
+#pragma once
+
+#include "cccbank.h"
+#include "checking.h"
+#include "digest.h"
+#include "journal.h"
+
+#include <algorithm>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// snapshot account types
+enum SnapshotType
+{
+    SNAPSHOT_ACCOUNT = 0,
+    SNAPSHOT_CHECKING = 1
+};
+
+// snapshot of one account
+struct SnapshotEntry
+{
+    int account;
+    unsigned char type;
+    Money giro;
+    Money balance;
+    PasswordDigest digest;
+};
+
+// versioned binary bank snapshot
+// * header (40 bytes): magic (8 bytes), version (4 bytes), record size (4 bytes),
+//   number of accounts (8 bytes), number of checking accounts (8 bytes), journal position (8 bytes)
+// * one fixed-size record per account (56 bytes): account (4 bytes), type (1 byte), reserved (3 bytes),
+//   giro in cents (8 bytes), balance in cents (8 bytes), password digest (32 bytes)
+// * the journal position is the sequence number of the last journaled record the snapshot contains,
+//   so a restart loads the snapshot and replays only the newer records of the journal
+class Snapshot
+{
+public:
+
+    static const unsigned int version = 4;
+    static const size_t header_size = 40;
+    static const size_t record_size = 56;
+
+    Snapshot()
+        : plain_(NULL), checking_(NULL), plain_count_(0), checking_count_(0), position_(0) {}
+
+    // destroy the restored accounts
+    ~Snapshot() {
+        for (size_t i = 0; i < plain_count_; i++) plain_[i].~Account();
+        for (size_t i = 0; i < checking_count_; i++) checking_[i].~CheckingAccount();
+
+        operator delete(plain_);
+        operator delete(checking_);
+    }
+
+    // capture all accounts of a bank at one point in time
+    // * only copies the accounts, so the bank is blocked as briefly as possible
+    template <class B>
+    static void capture(B &bank, vector<SnapshotEntry> *entries) {
+        entries->clear();
+
+        bank.for_each_account([entries](int account_nr, ProtectedAccount &it) {
+            CheckingAccount *checking = dynamic_cast<CheckingAccount *>(it.account);
+
+            SnapshotEntry entry;
+            entry.account = account_nr;
+            entry.type = checking ? SNAPSHOT_CHECKING : SNAPSHOT_ACCOUNT;
+            entry.giro = checking ? checking->get_giro() : Money();
+            entry.balance = it.account->balance();
+            entry.digest = it.digest;
+
+            entries->push_back(entry);
+        });
+    }
+
+    // capture all accounts of the bank behind a journaled bank
+    // * no mutation is applied during the capture
+    // * returns the journal position of the captured accounts
+    template <class B>
+    static unsigned long long capture(JournalBank &journaled, B &bank, vector<SnapshotEntry> *entries) {
+        return journaled.quiesce([&bank, entries]() { capture(bank, entries); });
+    }
+
+    // write captured accounts to a snapshot file
+    // * together with the journal position of the accounts, if any
+    // * the file is written under a temporary name and renamed when complete
+    // * returns true if the snapshot could be written
+    static bool write(const string &filename, const vector<SnapshotEntry> &entries, unsigned long long position = 0) {
+        unsigned long long count = entries.size();
+        unsigned long long checking = 0;
+
+        for (size_t i = 0; i < entries.size(); i++)
+            if (entries[i].type == SNAPSHOT_CHECKING) checking++;
+
+        vector<char> data(header_size+count*record_size);
+        char *ptr = &data[0];
+
+        unsigned int v = version;
+        unsigned int r = record_size;
+
+        memcpy(ptr, magic(), 8);
+        memcpy(ptr+8, &v, 4);
+        memcpy(ptr+12, &r, 4);
+        memcpy(ptr+16, &count, 8);
+        memcpy(ptr+24, &checking, 8);
+        memcpy(ptr+32, &position, 8);
+
+        char *record = ptr+header_size;
+
+        for (size_t i = 0; i < entries.size(); i++, record += record_size) {
+            const SnapshotEntry &entry = entries[i];
+            long long giro = entry.giro.cents();
+            long long balance = entry.balance.cents();
+
+            memcpy(record, &entry.account, 4);
+            record[4] = entry.type;
+            memcpy(record+8, &giro, 8);
+            memcpy(record+16, &balance, 8);
+            memcpy(record+24, entry.digest.bytes(), PasswordDigest::size);
+        }
+
+        string tmpname = filename+".tmp";
+
+        int fd = open(tmpname.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+        if (fd < 0) return false;
+
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t bytes = ::write(fd, &data[written], data.size()-written);
+            if (bytes <= 0) break;
+            written += bytes;
+        }
+
+        bool ok = (written == data.size() && fdatasync(fd) == 0);
+        close(fd);
+
+        if (!ok || rename(tmpname.c_str(), filename.c_str()) != 0) {
+            remove(tmpname.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    // load a snapshot file into a fresh bank
+    // * the file is memory-mapped and read in one linear pass
+    // * the accounts are placed in two contiguous arrays owned by the snapshot,
+    //   so the snapshot object must live as long as the bank uses the accounts
+    // * returns true if the snapshot could be loaded
+    // * a corrupt snapshot or a bank that already holds accounts is rejected and the bank is left unchanged
+    bool load(const string &filename, CCCBank *bank) {
+        if (plain_ != NULL || checking_ != NULL) return false;
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < header_size) {
+            close(fd);
+            return false;
+        }
+
+        size_t size = st.st_size;
+        void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (map == MAP_FAILED) return false;
+        madvise(map, size, MADV_SEQUENTIAL);
+
+        bool ok = restore((const char *)map, size, bank);
+
+        munmap(map, size);
+
+        return ok;
+    }
+
+    // rebuild a fresh bank from a snapshot and the journal that continues it
+    // * the snapshot is loaded and then the journal records after its position are replayed
+    // * returns the number of replayed records
+    //   or -1 if the snapshot could not be loaded or the journal does not reach its position
+    long long recover(const string &filename, const string &journal, CCCBank *bank) {
+        if (!load(filename, bank)) return -1;
+
+        return Journal::replay(journal, *bank, position_);
+    }
+
+    // return the journal position of the loaded snapshot
+    unsigned long long position() const {
+        return position_;
+    }
+
+    // background snapshot writer
+    // * captures the bank at the start and writes the file on a separate thread,
+    //   so mutations can continue while the snapshot is written
+    class Writer
+    {
+    public:
+
+        template <class B>
+        Writer(B &bank, const string &filename)
+            : ok_(false) {
+            vector<SnapshotEntry> *entries = new vector<SnapshotEntry>;
+            capture(bank, entries);
+
+            start(filename, entries, 0);
+        }
+
+        // snapshot of the bank behind a journaled bank, which records the journal position
+        template <class B>
+        Writer(JournalBank &journaled, B &bank, const string &filename)
+            : ok_(false) {
+            vector<SnapshotEntry> *entries = new vector<SnapshotEntry>;
+            unsigned long long position = capture(journaled, bank, entries);
+
+            start(filename, entries, position);
+        }
+
+        ~Writer() {
+            wait();
+        }
+
+        // wait for the snapshot to be written
+        // * returns true if it could be written
+        bool wait() {
+            if (thread_.joinable()) thread_.join();
+            return ok_;
+        }
+
+    protected:
+
+        void start(const string &filename, vector<SnapshotEntry> *entries, unsigned long long position) {
+            thread_ = thread([this, entries, filename, position]() {
+                ok_ = write(filename, *entries, position);
+                delete entries;
+            });
+        }
+
+        bool ok_;
+        thread thread_;
+    };
+
+protected:
+
+    static const char *magic() {
+        return "CCCSNAP\n";
+    }
+
+    // rebuild the bank from the mapped snapshot data
+    // * all records are validated in a first pass, so the bank is only changed by a valid snapshot
+    // * the accounts are constructed and inserted in a second pass, which cannot fail
+    bool restore(const char *data, size_t size, CCCBank *bank) {
+        unsigned int v, r;
+        unsigned long long count, checking, position;
+
+        if (memcmp(data, magic(), 8) != 0) return false;
+
+        memcpy(&v, data+8, 4);
+        memcpy(&r, data+12, 4);
+        memcpy(&count, data+16, 8);
+        memcpy(&checking, data+24, 8);
+        memcpy(&position, data+32, 8);
+
+        // the count is bounded by the file size before it is multiplied, so a corrupt header cannot wrap
+        if (v != version || r != record_size || checking > count) return false;
+        if (count > (size-header_size)/record_size || size != header_size+count*record_size) return false;
+
+        // validation pass
+        // * only known account types are accepted and they must match the header
+        // * a duplicate account number means a corrupt snapshot
+        vector<int> numbers(count);
+        unsigned long long checked = 0;
+
+        const char *record = data+header_size;
+
+        for (unsigned long long i = 0; i < count; i++, record += record_size) {
+            if (record[4] == SNAPSHOT_CHECKING) checked++;
+            else if (record[4] != SNAPSHOT_ACCOUNT) return false;
+
+            memcpy(&numbers[i], record, 4);
+        }
+
+        if (checked != checking) return false;
+
+        sort(numbers.begin(), numbers.end());
+        if (adjacent_find(numbers.begin(), numbers.end()) != numbers.end()) return false;
+
+        bool empty = true;
+        bank->for_each_account([&empty](int, ProtectedAccount &) { empty = false; });
+        if (!empty) return false;
+
+        // construction pass
+        plain_ = (Account *)operator new((count-checking)*sizeof(Account));
+        checking_ = (CheckingAccount *)operator new(checking*sizeof(CheckingAccount));
+
+        record = data+header_size;
+
+        for (unsigned long long i = 0; i < count; i++, record += record_size) {
+            int account_nr;
+            long long giro, balance;
+
+            memcpy(&account_nr, record, 4);
+            memcpy(&giro, record+8, 8);
+            memcpy(&balance, record+16, 8);
+
+            Account *a;
+
+            if (record[4] == SNAPSHOT_CHECKING)
+                a = new (&checking_[checking_count_++]) CheckingAccount(Money::from_cents(giro), Money::from_cents(balance));
+            else
+                a = new (&plain_[plain_count_++]) Account(Money::from_cents(balance));
+
+            bank->restore_account(account_nr, PasswordDigest::from_bytes((const unsigned char *)record+24), a);
+        }
+
+        position_ = position;
+
+        return true;
+    }
+
+    Account *plain_;
+    CheckingAccount *checking_;
+    size_t plain_count_, checking_count_;
+    unsigned long long position_; // journal position of the loaded snapshot
+};
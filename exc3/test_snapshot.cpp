@@ -0,0 +1,262 @@
+#include "journal.h"
+#include "lockedbank.h"
+#include "snapshot.h"
+
+#include "checking.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+// thread-safe CCC-Bank whose accounts can be captured
+typedef LockedBank<CCCBank> SharedBank;
+
+static const int accounts = 2000;
+
+string password(int account_nr)
+{
+    return "pw" + to_string(account_nr);
+}
+
+// open every third account as checking account and the others as plain accounts
+void fill(Bank &bank)
+{
+    for (int i=1; i<=accounts; i++)
+    {
+        Account *a = (i%3 == 0) ? (Account *)new CheckingAccount(Money::from_cents(100*i)) : new Account();
+        bank.open_account(i, password(i), a);
+        bank.deposit(i, Money::from_cents(1000+i));
+    }
+}
+
+// mutate a bank on a number of threads until "done" is set
+// * with "deposits" the threads also deposit, otherwise only the total balance is kept
+vector<thread> mutate(Bank &bank, atomic<bool> &done, bool deposits)
+{
+    vector<thread> workers;
+
+    for (int t=0; t<4; t++)
+        workers.push_back(thread([&bank, &done, deposits, t]() {
+            unsigned int r = t+1;
+            while (!done)
+            {
+                r = r*1103515245+12345;
+                int from = (r>>8)%accounts+1;
+                int to = (r>>20)%accounts+1;
+
+                bank.transfer(from, to, password(from), Money::from_cents(r%5000));
+                if (deposits) bank.deposit(to, Money::from_cents(r%100+1));
+            }
+        }));
+
+    return workers;
+}
+
+void stop(vector<thread> &workers, atomic<bool> &done)
+{
+    done = true;
+    for (unsigned int t=0; t<workers.size(); t++)
+        workers[t].join();
+}
+
+// capture the accounts of a bank sorted by account number
+template <class B>
+vector<SnapshotEntry> accounts_of(B &bank)
+{
+    vector<SnapshotEntry> entries;
+    Snapshot::capture(bank, &entries);
+
+    sort(entries.begin(), entries.end(), [](const SnapshotEntry &a, const SnapshotEntry &b) {
+        return a.account < b.account;
+    });
+
+    return entries;
+}
+
+// compare account number, type, giro, digest and optionally the balance of all accounts
+bool same(const vector<SnapshotEntry> &a, const vector<SnapshotEntry> &b, bool balances)
+{
+    if (a.size() != b.size()) return false;
+
+    for (size_t i=0; i<a.size(); i++)
+        if (a[i].account != b[i].account || a[i].type != b[i].type || a[i].giro != b[i].giro ||
+            !a[i].digest.equals(b[i].digest) || (balances && a[i].balance != b[i].balance)) return false;
+
+    return true;
+}
+
+bool check(bool ok, const char *what)
+{
+    if (!ok) cerr << "FAILED: " << what << endl;
+    return ok;
+}
+
+// snapshot a bank while other threads keep transferring
+bool test_concurrent(const string &filename)
+{
+    bool ok = true;
+
+    SharedBank bank;
+    fill(bank);
+
+    atomic<bool> done(false);
+    vector<thread> workers = mutate(bank, done, false);
+
+    this_thread::sleep_for(chrono::milliseconds(20));
+
+    Snapshot::Writer writer(bank, filename);
+    ok &= check(writer.wait(), "concurrent snapshot written");
+
+    stop(workers, done);
+
+    CCCBank loaded;
+    Snapshot snapshot;
+
+    ok &= check(snapshot.load(filename, &loaded), "concurrent snapshot loaded");
+    ok &= check(same(accounts_of(loaded), accounts_of(bank), false), "concurrent snapshot accounts");
+
+    // the transfers keep the total, so a consistent capture has the same total
+    ok &= check(loaded.total_balance() == bank.total_balance(), "concurrent snapshot total balance");
+
+    // a quiet snapshot matches every balance and the passwords still authenticate
+    Snapshot::Writer quiet(bank, filename);
+    ok &= check(quiet.wait(), "quiet snapshot written");
+
+    CCCBank reloaded;
+    Snapshot resnapshot;
+
+    ok &= check(resnapshot.load(filename, &reloaded), "quiet snapshot loaded");
+    ok &= check(same(accounts_of(reloaded), accounts_of(bank), true), "quiet snapshot accounts");
+    ok &= check(reloaded.balance(3, password(3)) == bank.balance(3, password(3)), "quiet snapshot password");
+
+    return ok;
+}
+
+// snapshot a journaled bank and recover it from the snapshot and the rest of the journal
+bool test_recover(const string &filename, const string &journalname)
+{
+    bool ok = true;
+
+    remove(journalname.c_str());
+
+    SharedBank bank;
+    Journal journal(journalname);
+    JournalBank journaled(&bank, &journal, false);
+
+    fill(journaled);
+
+    atomic<bool> done(false);
+    vector<thread> workers = mutate(journaled, done, true);
+
+    this_thread::sleep_for(chrono::milliseconds(20));
+
+    Snapshot::Writer writer(journaled, bank, filename);
+    ok &= check(writer.wait(), "journaled snapshot written");
+
+    this_thread::sleep_for(chrono::milliseconds(20));
+
+    stop(workers, done);
+    ok &= check(journal.sync(), "journal synced");
+
+    CCCBank recovered;
+    Snapshot snapshot;
+
+    long long records = snapshot.recover(filename, journalname, &recovered);
+
+    ok &= check(snapshot.position() > 0 && snapshot.position() < journal.durable(), "snapshot position inside the journal");
+    ok &= check(records >= 0 && (unsigned long long)records == journal.durable()-snapshot.position(), "records after the snapshot replayed");
+    ok &= check(same(accounts_of(recovered), accounts_of(bank), true), "recovered accounts");
+    ok &= check(recovered.total_balance() == journaled.total_balance(), "recovered total balance");
+
+    remove(journalname.c_str());
+
+    return ok;
+}
+
+// a corrupt snapshot must be rejected without changing the bank
+bool rejected(const string &filename, const vector<char> &data, const char *what)
+{
+    FILE *file = fopen(filename.c_str(), "wb");
+    fwrite(&data[0], 1, data.size(), file);
+    fclose(file);
+
+    CCCBank bank;
+    Snapshot snapshot;
+
+    return check(!snapshot.load(filename, &bank) && accounts_of(bank).empty() && bank.total_balance() == Money(), what);
+}
+
+bool test_corrupt(const string &filename)
+{
+    bool ok = true;
+
+    SharedBank bank;
+    fill(bank);
+
+    ok &= check(Snapshot::Writer(bank, filename).wait(), "snapshot written");
+
+    vector<char> data;
+    FILE *file = fopen(filename.c_str(), "rb");
+    char block[65536];
+    size_t bytes;
+    while ((bytes = fread(block, 1, sizeof(block), file)) > 0)
+        data.insert(data.end(), block, block+bytes);
+    fclose(file);
+
+    size_t last = Snapshot::header_size+(accounts-1)*Snapshot::record_size;
+
+    vector<char> type = data;
+    type[last+4] = 7;
+    ok &= rejected(filename, type, "unknown account type rejected");
+
+    vector<char> count = data;
+    count[last+4] = (count[last+4] == SNAPSHOT_CHECKING) ? SNAPSHOT_ACCOUNT : SNAPSHOT_CHECKING;
+    ok &= rejected(filename, count, "wrong number of checking accounts rejected");
+
+    vector<char> duplicate = data;
+    memcpy(&duplicate[last], &duplicate[Snapshot::header_size], 4);
+    ok &= rejected(filename, duplicate, "duplicate account number rejected");
+
+    vector<char> truncated(data.begin(), data.end()-1);
+    ok &= rejected(filename, truncated, "truncated snapshot rejected");
+
+    // a bank that already holds accounts is not overwritten
+    CCCBank used;
+    used.open_account(1, "", new Account());
+
+    Snapshot snapshot;
+    FILE *valid = fopen(filename.c_str(), "wb");
+    fwrite(&data[0], 1, data.size(), valid);
+    fclose(valid);
+
+    ok &= check(!snapshot.load(filename, &used) && accounts_of(used).size() == 1, "used bank rejected");
+
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    string filename = "test_snapshot.snap";
+    string journalname = "test_snapshot.log";
+
+    // silence the event log of the CCC-Bank
+    event_log().set_level(LOG_OFF);
+
+    bool ok = true;
+
+    ok &= test_concurrent(filename);
+    ok &= test_recover(filename, journalname);
+    ok &= test_corrupt(filename);
+
+    remove(filename.c_str());
+
+    cout << (ok ? "passed" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
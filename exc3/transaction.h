@@ -0,0 +1,126 @@
+#pragma once
+
+#include "bank.h"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// account version seen by a transaction
+struct TransactionRead
+{
+    int account;
+    unsigned long long version;
+};
+
+// buffered write of a transaction
+struct TransactionWrite
+{
+    int account;
+    Money amount;
+    bool withdraw; // withdrawal (authenticated by passwd) or deposit
+    string passwd;
+};
+
+// optimistic multi-account transaction
+// * reads go to the bank immediately and record the version of the account
+// * writes are buffered and applied by commit, which first validates that
+//   no account read by the transaction has changed in the meantime
+// * reads see the committed balances, not the buffered writes of the transaction
+class Transaction
+{
+public:
+
+    Transaction(Bank *bank)
+        : bank_(bank) {}
+
+    // read the balance of an account
+    // * returns false if the account does not exist or passwd is wrong
+    bool read(int account_nr, string_view passwd, Money *balance) {
+        TransactionRead read;
+        read.account = account_nr;
+
+        if (!bank_->read_version(account_nr, passwd, balance, &read.version)) return false;
+
+        reads_.push_back(read);
+
+        return true;
+    }
+
+    // buffer a deposit
+    // * returns false if the amount is not positive
+    bool deposit(int account_nr, Money amount) {
+        return write(account_nr, amount, false, string_view());
+    }
+
+    // buffer a withdrawal
+    // * the password is checked at commit
+    // * returns false if the amount is not positive
+    bool withdraw(int account_nr, string_view passwd, Money amount) {
+        return write(account_nr, amount, true, passwd);
+    }
+
+    // buffer a transfer as a withdrawal and a deposit
+    // * returns false if the amount is not positive
+    bool transfer(int from, int to, string_view passwd, Money amount) {
+        return withdraw(from, passwd, amount) && deposit(to, amount);
+    }
+
+    // validate and apply the buffered writes
+    TransactionResult commit() {
+        return bank_->commit(*this);
+    }
+
+    // forget all reads and writes
+    void clear() {
+        reads_.clear();
+        writes_.clear();
+    }
+
+    const vector<TransactionRead> &reads() const { return reads_; }
+    const vector<TransactionWrite> &writes() const { return writes_; }
+
+protected:
+
+    bool write(int account_nr, Money amount, bool withdraw, string_view passwd) {
+        if (amount <= Money()) return false;
+
+        TransactionWrite write;
+        write.account = account_nr;
+        write.amount = amount;
+        write.withdraw = withdraw;
+        write.passwd = passwd;
+
+        writes_.push_back(write);
+
+        return true;
+    }
+
+    Bank *bank_;
+
+    vector<TransactionRead> reads_;
+    vector<TransactionWrite> writes_;
+};
+
+// build and commit a transaction until it does not conflict
+// * build(tx) fills the transaction and returns false to abort it
+// * gives up after "retries" conflicts
+template <class F>
+TransactionResult run_transaction(Bank *bank, F build, unsigned int retries = 1000)
+{
+    Transaction tx(bank);
+
+    for (unsigned int i = 0; ; i++) {
+        tx.clear();
+
+        if (!build(tx)) return TX_ABORTED;
+
+        TransactionResult result = tx.commit();
+        if (result != TX_CONFLICT || i >= retries) return result;
+
+        this_thread::yield();
+    }
+}
@@ -10,6 +10,22 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
 
 #ifdef _MSC_VER
 #define strdup _strdup
@@ -41,6 +57,21 @@ unsigned char *lglReadRawData(const char *filename,
                               unsigned int *components=NULL,unsigned int *bits=NULL,bool *sign=NULL,bool *msb=NULL,
                               float *scalex=NULL,float *scaley=NULL,float *scalez=NULL); // meters
 
+// map raw data
+//  the raw file is mapped into memory, so no data is read or copied up front
+//  the mapping is copy-on-write, so the data can be modified without changing the file
+//  the access hint tells the kernel whether to read ahead or not
+unsigned char *lglMapRawData(const char *filename,
+                             long long *width,long long *height,long long *depth,
+                             unsigned int *components=NULL,unsigned int *bits=NULL,bool *sign=NULL,bool *msb=NULL,
+                             float *scalex=NULL,float *scaley=NULL,float *scalez=NULL, // meters
+                             bool random=false);
+
+// unmap raw data
+void lglUnmapRawData(unsigned char *data,
+                     long long width,long long height,long long depth,
+                     unsigned int components=1,unsigned int bits=8);
+
 // analyze raw file format
 bool lglReadRawInfo(char *filename,
                     long long *width,long long *height,long long *depth,
@@ -71,9 +102,11 @@ unsigned char *lglStretchRaw(unsigned short int *data,
                              unsigned int components);
 
 // quantize 16-bit raw data to 8-bit using a non-linear mapping
+//  the mapping does not depend on the number of threads
 unsigned char *lglQuantizeRaw(unsigned short int *data,
                               long long width,long long height,long long depth,
-                              bool linear=false);
+                              bool linear=false,
+                              unsigned int threads=0);
 
 // load and quantize raw data
 unsigned char *lglLoadRawData(const char *filename,
@@ -405,6 +438,108 @@ inline unsigned char *lglReadRawData(const char *filename,
    return(volume);
 }
 
+// map raw data
+inline unsigned char *lglMapRawData(const char *filename,
+                                    long long *width,long long *height,long long *depth,
+                                    unsigned int *components,unsigned int *bits,bool *sign,bool *msb,
+                                    float *scalex,float *scaley,float *scalez,
+                                    bool random)
+{
+   char *name;
+
+   unsigned char *volume;
+   long long bytes;
+
+   // analyze raw info
+   name=strdup(filename);
+   if (!lglReadRawInfo(name,
+                       width,height,depth,
+                       components,bits,sign,msb,
+                       scalex,scaley,scalez))
+   {
+      free(name);
+      return(NULL);
+   }
+   free(name);
+
+   bytes=(*width)*(*height)*(*depth)*(*components);
+
+   if (bits!=NULL)
+      if (*bits==16) bytes*=2;
+
+#ifndef _WIN32
+
+   int fd;
+   struct stat st;
+
+   // open raw file
+   if ((fd=open(filename,O_RDONLY))<0) return(NULL);
+
+   if (fstat(fd,&st)!=0 || st.st_size<bytes)
+   {
+      close(fd);
+      return(NULL);
+   }
+
+   // map raw chunk
+   volume=(unsigned char *)mmap(NULL,(size_t)bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+   close(fd);
+
+   if (volume==MAP_FAILED) return(NULL);
+
+   madvise(volume,(size_t)bytes,random?MADV_RANDOM:MADV_SEQUENTIAL);
+
+#else
+
+   HANDLE file,mapping;
+   LARGE_INTEGER size;
+
+   // open raw file
+   if ((file=CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+                         random?FILE_FLAG_RANDOM_ACCESS:FILE_FLAG_SEQUENTIAL_SCAN,NULL))==INVALID_HANDLE_VALUE)
+      return(NULL);
+
+   if (!GetFileSizeEx(file,&size) || size.QuadPart<bytes)
+   {
+      CloseHandle(file);
+      return(NULL);
+   }
+
+   // map raw chunk
+   if ((mapping=CreateFileMappingA(file,NULL,PAGE_WRITECOPY,0,0,NULL))==NULL)
+   {
+      CloseHandle(file);
+      return(NULL);
+   }
+
+   volume=(unsigned char *)MapViewOfFile(mapping,FILE_MAP_COPY,0,0,(SIZE_T)bytes);
+
+   CloseHandle(mapping);
+   CloseHandle(file);
+
+#endif
+
+   return(volume);
+}
+
+// unmap raw data
+inline void lglUnmapRawData(unsigned char *data,
+                            long long width,long long height,long long depth,
+                            unsigned int components,unsigned int bits)
+{
+   long long bytes;
+
+   bytes=width*height*depth*components;
+
+   if (bits==16) bytes*=2;
+
+#ifndef _WIN32
+   munmap(data,(size_t)bytes);
+#else
+   UnmapViewOfFile(data);
+#endif
+}
+
 // write raw data
 inline char *lglWriteRawData(const char *filename, // /wo suffix .raw
                              unsigned char *volume,
@@ -580,33 +715,209 @@ inline double lglGetRawGradMag(unsigned short int *data,
    return(sqrt(gx*gx+gy*gy+gz*gz));
 }
 
+// helper to compute the square root of the gradient magnitude of each voxel of a row
+//  the rows ym/yp and zm/zp are the neighbours of the row in y and z direction
+//  their differences are scaled by fy and fz (1/2 for central, 1 for one-sided and 0 for no differences)
+//  the interior voxels are handled without branches
+inline void lglComputeRawGradRow(const unsigned short int *row,
+                                 const unsigned short int *ym,const unsigned short int *yp,double fy,
+                                 const unsigned short int *zm,const unsigned short int *zp,double fz,
+                                 long long width,
+                                 double *grad)
+{
+   long long i;
+
+   double gx,gy,gz;
+
+   for (i=1; i<width-1; i++)
+   {
+      gx=(row[i+1]-row[i-1])*0.5;
+      gy=(yp[i]-ym[i])*fy;
+      gz=(zp[i]-zm[i])*fz;
+
+      grad[i]=gx*gx+gy*gy+gz*gz;
+   }
+
+#ifdef __SSE2__
+   for (i=1; i+1<width-1; i+=2)
+      _mm_storeu_pd(&grad[i],_mm_sqrt_pd(_mm_sqrt_pd(_mm_loadu_pd(&grad[i]))));
+   for (; i<width-1; i++) grad[i]=sqrt(sqrt(grad[i]));
+#else
+   for (i=1; i<width-1; i++) grad[i]=sqrt(sqrt(grad[i]));
+#endif
+
+   for (i=0; i<width; i+=(width>1)?width-1:1)
+   {
+      if (i>0) gx=row[i]-row[i-1];
+      else if (i<width-1) gx=row[i+1]-row[i];
+      else gx=0.0;
+
+      gy=(yp[i]-ym[i])*fy;
+      gz=(zp[i]-zm[i])*fz;
+
+      grad[i]=sqrt(sqrt(gx*gx+gy*gy+gz*gz));
+   }
+}
+
+// helper to run a job for a number of slabs in parallel
+template <class F>
+inline void lglParallelRawSlabs(unsigned int slabs,F job)
+{
+   std::vector<std::thread> workers;
+
+   for (unsigned int n=1; n<slabs; n++) workers.push_back(std::thread(job,n));
+   job(0);
+
+   for (unsigned int n=0; n<workers.size(); n++) workers[n].join();
+}
+
+// helper to run a number of jobs on a number of threads
+//  the jobs are handed out in order
+template <class F>
+inline void lglParallelRawJobs(unsigned int jobs,unsigned int threads,F job)
+{
+   std::atomic<unsigned int> next(0);
+
+   if (threads>jobs) threads=jobs;
+
+   lglParallelRawSlabs(threads,[&](unsigned int)
+   {
+      unsigned int n;
+      while ((n=next++)<jobs) job(n);
+   });
+}
+
+// helper to accumulate the gradient magnitude histogram of a volume
+//  the histogram entry of each voxel value is increased by the square root of the gradient magnitude
+//  the gradients of a batch of rows are computed on all threads
+//   while one thread adds the gradients of the previous batch to the histogram
+//  the gradients are added in voxel order, so each histogram entry is summed in the same order
+//   as by a serial pass and the histogram does not depend on the number of threads
+inline void lglAccumulateRawGradHist(const unsigned short int *data,
+                                     long long width,long long height,long long depth,
+                                     double *err,
+                                     unsigned int threads)
+{
+   long long i;
+
+   long long rows,batch,r0;
+   unsigned int cur,prev;
+
+   rows=height*depth;
+
+   batch=(1<<20)/width;
+   if (batch<1) batch=1;
+   if (batch>rows) batch=rows;
+
+   std::vector<double> grad[2];
+
+   grad[0].resize((size_t)(batch*width));
+   grad[1].resize((size_t)(batch*width));
+
+   for (i=0; i<65536; i++) err[i]=0.0;
+
+   for (r0=0; r0<rows+batch; r0+=batch)
+   {
+      cur=(unsigned int)((r0<rows)?((rows-r0<batch)?rows-r0:batch):0);
+      prev=(unsigned int)((r0>0)?((rows-r0+batch<batch)?rows-r0+batch:batch):0);
+
+      lglParallelRawJobs(cur+1,threads,[&](unsigned int n)
+      {
+         long long i,j,k,r;
+
+         const unsigned short int *row,*ym,*yp,*zm,*zp;
+         double fy,fz,*g;
+
+         // the first job adds the previous batch
+         if (n==0)
+         {
+            g=&grad[(r0/batch+1)%2][0];
+
+            for (r=r0-batch; r<r0-batch+prev; r++,g+=width)
+            {
+               row=data+r*width;
+               for (i=0; i<width; i++) err[row[i]]+=g[i];
+            }
+
+            return;
+         }
+
+         r=r0+n-1;
+
+         j=r%height;
+         k=r/height;
+
+         row=data+r*width;
+
+         ym=(j>0)?row-width:row;
+         yp=(j<height-1)?row+width:row;
+         fy=(j>0 && j<height-1)?0.5:(height>1)?1.0:0.0;
+
+         zm=(k>0)?row-width*height:row;
+         zp=(k<depth-1)?row+width*height:row;
+         fz=(k>0 && k<depth-1)?0.5:(depth>1)?1.0:0.0;
+
+         lglComputeRawGradRow(row,ym,yp,fy,zm,zp,fz,width,&grad[(r0/batch)%2][(size_t)(n-1)*width]);
+      });
+   }
+}
+
 // quantize 16-bit raw data to 8-bit using a non-linear mapping
+//  the volume is processed on all available cores or on the given number of threads
+//  the min/max and the mapping pass work on slabs of slices
 inline unsigned char *lglQuantizeRaw(unsigned short int *data,
                                      long long width,long long height,long long depth,
-                                     bool linear)
+                                     bool linear,
+                                     unsigned int threads)
 {
-   long long i,j,k;
+   long long i,k;
 
    unsigned char *data2;
-   long long cells;
+   unsigned int t,slabs;
 
-   int v,vmin,vmax;
+   int vmin,vmax;
+   std::vector<int> tmin,tmax;
 
    double *err,eint;
 
    bool done;
 
+   if (threads==0) threads=std::thread::hardware_concurrency();
+   if (threads<1) threads=1;
+
+   slabs=threads;
+   if (slabs>depth) slabs=(unsigned int)depth;
+
+   tmin.resize(slabs);
+   tmax.resize(slabs);
+
+   lglParallelRawSlabs(slabs,[&](unsigned int n)
+   {
+      long long idx,idx0,idx1;
+      int v;
+
+      idx0=depth*n/slabs*width*height;
+      idx1=depth*(n+1)/slabs*width*height;
+
+      tmin[n]=65535;
+      tmax[n]=0;
+
+      for (idx=idx0; idx<idx1; idx++)
+      {
+         v=data[idx];
+         if (v<tmin[n]) tmin[n]=v;
+         if (v>tmax[n]) tmax[n]=v;
+      }
+   });
+
    vmin=65535;
    vmax=0;
 
-   for (k=0; k<depth; k++)
-      for (j=0; j<height; j++)
-         for (i=0; i<width; i++)
-         {
-            v=lglGetRawValue(data,width,height,depth,i,j,k);
-            if (v<vmin) vmin=v;
-            if (v>vmax) vmax=v;
-         }
+   for (t=0; t<slabs; t++)
+   {
+      if (tmin[t]<vmin) vmin=tmin[t];
+      if (tmax[t]>vmax) vmax=tmax[t];
+   }
 
    if (vmin==vmax) vmax=vmin+1;
 
@@ -618,12 +929,7 @@ inline unsigned char *lglQuantizeRaw(unsigned short int *data,
       for (i=0; i<65536; i++) err[i]=255*(double)(i-vmin)/(vmax-vmin);
    else
    {
-      for (i=0; i<65536; i++) err[i]=0.0;
-
-      for (k=0; k<depth; k++)
-         for (j=0; j<height; j++)
-            for (i=0; i<width; i++)
-               err[lglGetRawValue(data,width,height,depth,i,j,k)]+=sqrt(lglGetRawGradMag(data,width,height,depth,i,j,k));
+      lglAccumulateRawGradHist(data,width,height,depth,err,threads);
 
       for (i=0; i<65536; i++) err[i]=pow(err[i],1.0/3);
 
@@ -651,18 +957,24 @@ inline unsigned char *lglQuantizeRaw(unsigned short int *data,
          for (i=0; i<65536; i++) err[i]*=255.0/err[65535];
    }
 
-   cells=width*height*depth;
-
-   if ((data2=(unsigned char *)malloc((size_t)cells))==NULL)
+   if ((data2=(unsigned char *)malloc((size_t)(width*height*depth)))==NULL)
    {
-      delete err;
+      delete[] err;
       return(NULL);
    }
 
-   for (i=0; i<cells; i++)
-      data2[i]=(int)(err[data[i]]+0.5);
+   lglParallelRawSlabs(slabs,[&](unsigned int n)
+   {
+      long long idx,idx0,idx1;
+
+      idx0=depth*n/slabs*width*height;
+      idx1=depth*(n+1)/slabs*width*height;
+
+      for (idx=idx0; idx<idx1; idx++)
+         data2[idx]=(int)(err[data[idx]]+0.5);
+   });
 
-   delete err;
+   delete[] err;
 
    return(data2);
 }
@@ -2,34 +2,65 @@
 
 #include "ddsbase.h"
 
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #define DDS_MAXSTR (256)
+#define DDS_MAXHEADER (1<<16)
 
 #define DDS_BLOCKSIZE (1<<20)
 #define DDS_INTERLEAVE (1<<24)
+#define DDS_CHUNKSIZE (1<<22)
 
 #define DDS_RL (7)
 
+// the delta ring of the encoder holds a batch plus the two pending runs
+#define DDS_RING (1024)
+#define DDS_BATCH (512)
+
 #define DDS_ISINTEL (*((unsigned char *)(&DDS_INTEL)+1)==0)
 
 static char DDS_ID[]="DDS v3d\n";
 static char DDS_ID2[]="DDS v3e\n";
+static char DDS_ID3[]="DDS v3f\n";
+static char DDS_ID4[]="DDS v3g\n";
+static char DDS_ID5[]="DDS v3h\n";
+
+// bit-stream state of a single encoder or decoder
+// * every call of DDS_encode and DDS_decode works on its own context,
+//   so any number of streams can be coded concurrently
+struct DDS_context
+   {
+   unsigned char *cache;
+   unsigned int cachepos,cachesize;
 
-static unsigned char *DDS_cache;
-static unsigned int DDS_cachepos,DDS_cachesize;
+   unsigned long long buffer; // right-aligned bit buffer of the writer
+   unsigned int bufsize;
 
-static unsigned int DDS_buffer;
-static unsigned int DDS_bufsize;
+   unsigned long long bits; // left-aligned bit buffer of the reader
+   unsigned int bitcnt;
+   };
 
 static unsigned short int DDS_INTEL=1;
 
 // helper functions for DDS:
 
-inline unsigned int DDS_shiftl(const unsigned int value,const unsigned int bits)
-   {return((bits>=32)?0:value<<bits);}
-
-inline unsigned int DDS_shiftr(const unsigned int value,const unsigned int bits)
-   {return((bits>=32)?0:value>>bits);}
-
 inline void DDS_swapuint(unsigned int *x)
    {
    unsigned int tmp=*x;
@@ -40,189 +71,435 @@ inline void DDS_swapuint(unsigned int *x)
       ((tmp&0xff000000)>>24);
    }
 
-void DDS_initbuffer()
+inline unsigned long long DDS_swapuint64(unsigned long long x)
    {
-   DDS_buffer=0;
-   DDS_bufsize=0;
+#if defined(__GNUC__) || defined(__clang__)
+   return(__builtin_bswap64(x));
+#elif defined(_MSC_VER)
+   return(_byteswap_uint64(x));
+#else
+   return(((x&0xffULL)<<56)|((x&0xff00ULL)<<40)|((x&0xff0000ULL)<<24)|((x&0xff000000ULL)<<8)|
+          ((x>>8)&0xff000000ULL)|((x>>24)&0xff0000ULL)|((x>>40)&0xff00ULL)|(x>>56));
+#endif
    }
 
-inline void DDS_clearbits()
+inline void DDS_initbuffer(DDS_context *ctx)
    {
-   DDS_cache=NULL;
-   DDS_cachepos=0;
-   DDS_cachesize=0;
+   ctx->buffer=0;
+   ctx->bufsize=0;
+
+   ctx->bits=0;
+   ctx->bitcnt=0;
    }
 
-inline void DDS_writebits(unsigned int value,unsigned int bits)
+inline void DDS_clearbits(DDS_context *ctx)
    {
-   value&=DDS_shiftl(1,bits)-1;
+   ctx->cache=NULL;
+   ctx->cachepos=0;
+   ctx->cachesize=0;
+   }
 
-   if (DDS_bufsize+bits<32)
-      {
-      DDS_buffer=DDS_shiftl(DDS_buffer,bits)|value;
-      DDS_bufsize+=bits;
-      }
-   else
+// next size of a geometrically growing buffer
+// * a buffer of n bytes is thus reallocated only log(n) times
+inline unsigned int DDS_grow(unsigned int size)
+   {
+   if (size<DDS_BLOCKSIZE) return(DDS_BLOCKSIZE);
+   if (size>=0x80000000u) return(0xffffffffu);
+
+   return(2*size);
+   }
+
+// reserve the cache of the writer for the expected size of the bit stream
+inline void DDS_reservebits(DDS_context *ctx,unsigned int size)
+   {
+   if (size<=ctx->cachesize) return;
+
+   if ((ctx->cache=(unsigned char *)realloc(ctx->cache,size))==NULL) ERRORMSG();
+   ctx->cachesize=size;
+   }
+
+// append up to 32 bits to the bit stream
+// * the bits are collected in a 64-bit buffer,
+//   which is written as a big endian word as soon as it holds 32 bits
+inline void DDS_writebits(DDS_context *ctx,unsigned int value,unsigned int bits)
+   {
+   unsigned int word;
+
+   ctx->buffer=(ctx->buffer<<bits)|(value&((1ULL<<bits)-1));
+   ctx->bufsize+=bits;
+
+   if (ctx->bufsize>=32)
       {
-      DDS_buffer=DDS_shiftl(DDS_buffer,32-DDS_bufsize);
-      DDS_bufsize-=32-bits;
-      DDS_buffer|=DDS_shiftr(value,DDS_bufsize);
+      ctx->bufsize-=32;
 
-      if (DDS_cachepos+4>DDS_cachesize)
+      if (ctx->cachepos+4>ctx->cachesize)
          {
-         if (DDS_cache==NULL)
-            {
-            if ((DDS_cache=(unsigned char *)malloc(DDS_BLOCKSIZE))==NULL) ERRORMSG();
-            DDS_cachesize=DDS_BLOCKSIZE;
-            }
-         else
-            {
-            if ((DDS_cache=(unsigned char *)realloc(DDS_cache,DDS_cachesize+DDS_BLOCKSIZE))==NULL) ERRORMSG();
-            DDS_cachesize+=DDS_BLOCKSIZE;
-            }
+         if (ctx->cachesize==0xffffffffu) ERRORMSG();
+         DDS_reservebits(ctx,DDS_grow(ctx->cachesize));
          }
 
-      if (DDS_ISINTEL) DDS_swapuint(&DDS_buffer);
-      *((unsigned int *)&DDS_cache[DDS_cachepos])=DDS_buffer;
-      DDS_cachepos+=4;
+      word=(unsigned int)(ctx->buffer>>ctx->bufsize);
 
-      DDS_buffer=value&(DDS_shiftl(1,DDS_bufsize)-1);
+      if (DDS_ISINTEL) DDS_swapuint(&word);
+      memcpy(&ctx->cache[ctx->cachepos],&word,4);
+      ctx->cachepos+=4;
       }
    }
 
-inline void DDS_flushbits()
+inline void DDS_flushbits(DDS_context *ctx)
    {
    unsigned int bufsize;
 
-   bufsize=DDS_bufsize;
+   bufsize=ctx->bufsize;
 
    if (bufsize>0)
       {
-      DDS_writebits(0,32-bufsize);
-      DDS_cachepos-=(32-bufsize)/8;
+      DDS_writebits(ctx,0,32-bufsize);
+      ctx->cachepos-=(32-bufsize)/8;
       }
    }
 
-inline void DDS_savebits(unsigned char **data,unsigned int *size)
+inline void DDS_savebits(DDS_context *ctx,unsigned char **data,unsigned int *size)
    {
-   *data=DDS_cache;
-   *size=DDS_cachepos;
+   *data=ctx->cache;
+   *size=ctx->cachepos;
    }
 
-inline void DDS_loadbits(unsigned char *data,unsigned int size)
+inline void DDS_loadbits(DDS_context *ctx,unsigned char *data,unsigned int size)
    {
-   DDS_cache=data;
-   DDS_cachesize=size;
-
-   if ((DDS_cache=(unsigned char *)realloc(DDS_cache,DDS_cachesize+4))==NULL) ERRORMSG();
-   *((unsigned int *)&DDS_cache[DDS_cachesize])=0;
-
-   DDS_cachesize=4*((DDS_cachesize+3)/4);
-   if ((DDS_cache=(unsigned char *)realloc(DDS_cache,DDS_cachesize))==NULL) ERRORMSG();
+   ctx->cache=data;
+   ctx->cachesize=size;
    }
 
-inline unsigned int DDS_readbits(unsigned int bits)
+// refill the bit buffer of the reader to at least 56 bits
+// * loads 8 bytes at once and keeps the bits of the bytes that fit
+// * bits that are loaded twice are identical, so they are simply or'ed in again
+// * the stream is read as zeros beyond its end
+inline void DDS_refill(DDS_context *ctx)
    {
-   unsigned int value;
+   unsigned long long word;
 
-   if (bits<DDS_bufsize)
+   if (ctx->cachepos+8<=ctx->cachesize)
       {
-      DDS_bufsize-=bits;
-      value=DDS_shiftr(DDS_buffer,DDS_bufsize);
+      memcpy(&word,&ctx->cache[ctx->cachepos],8);
+      if (DDS_ISINTEL) word=DDS_swapuint64(word);
+
+      ctx->bits|=word>>ctx->bitcnt;
+      ctx->cachepos+=(63-ctx->bitcnt)>>3;
+      ctx->bitcnt|=56;
       }
    else
-      {
-      value=DDS_shiftl(DDS_buffer,bits-DDS_bufsize);
-
-      if (DDS_cachepos>=DDS_cachesize) DDS_buffer=0;
-      else
+      while (ctx->bitcnt<56)
          {
-         DDS_buffer=*((unsigned int *)&DDS_cache[DDS_cachepos]);
-         if (DDS_ISINTEL) DDS_swapuint(&DDS_buffer);
-         DDS_cachepos+=4;
+         if (ctx->cachepos<ctx->cachesize) ctx->bits|=(unsigned long long)ctx->cache[ctx->cachepos]<<(56-ctx->bitcnt);
+         ctx->cachepos++;
+         ctx->bitcnt+=8;
          }
+   }
 
-      DDS_bufsize+=32-bits;
-      value|=DDS_shiftr(DDS_buffer,DDS_bufsize);
-      }
+// take bits from the bit buffer without refilling it
+inline unsigned int DDS_takebits(DDS_context *ctx,unsigned int bits)
+   {
+   unsigned int value;
+
+   value=(unsigned int)((ctx->bits>>1)>>(63-bits));
 
-   DDS_buffer&=DDS_shiftl(1,DDS_bufsize)-1;
+   ctx->bits<<=bits;
+   ctx->bitcnt-=bits;
 
    return(value);
    }
 
+inline unsigned int DDS_readbits(DDS_context *ctx,unsigned int bits)
+   {
+   if (ctx->bitcnt<bits) DDS_refill(ctx);
+   return(DDS_takebits(ctx,bits));
+   }
+
 inline int DDS_code(int bits)
    {return(bits>1?bits-1:bits);}
 
 inline int DDS_decode(int bits)
    {return(bits>=1?bits+1:bits);}
 
-// deinterleave a byte stream
-void DDS_deinterleave(unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int block=0,BOOLINT restore=FALSE)
+// transpose the bytes of a tile of a byte stream
+// * the tile consists of records of skip bytes, which are split into skip planes
+//   holding the first, second, etc. byte of each record
+// * restore merges the planes back into records
+// * the records are transposed 16 at a time with byte shuffles,
+//   the remaining records are handled by the scalar loop
+void DDS_transpose(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip,BOOLINT restore)
    {
-   unsigned int i,j,k;
+   unsigned int i,r,n;
 
-   unsigned char *data2,*ptr;
+   unsigned int start[4];
+   unsigned char *plane[4];
 
-   if (skip<=1) return;
+   const unsigned char *in[4];
 
-   if (block==0)
-      {
-      if ((data2=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+   for (start[0]=0,i=1; i<skip; i++) start[i]=start[i-1]+(bytes-(i-1)+skip-1)/skip;
 
-      if (!restore)
-         for (ptr=data2,i=0; i<skip; i++)
-            for (j=i; j<bytes; j+=skip) *ptr++=data[j];
-      else
-         for (ptr=data,i=0; i<skip; i++)
-            for (j=i; j<bytes; j+=skip) data2[j]=*ptr++;
+   n=bytes/skip;
+   r=0;
 
-      memcpy(data,data2,bytes);
-      }
-   else
+   if (!restore)
       {
-      if ((data2=(unsigned char *)malloc((bytes<skip*block)?bytes:skip*block))==NULL) ERRORMSG();
+      for (i=0; i<skip; i++) plane[i]=dst+start[i];
 
-      if (!restore)
+#ifdef __SSE2__
+      if (skip==2)
          {
-         for (k=0; k<bytes/skip/block; k++)
+         __m128i m=_mm_set1_epi16(0xff);
+
+         for (; r+16<=n; r+=16)
             {
-            for (ptr=data2,i=0; i<skip; i++)
-               for (j=i; j<skip*block; j+=skip) *ptr++=data[k*skip*block+j];
+            __m128i a=_mm_loadu_si128((const __m128i *)(src+2*r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(src+2*r+16));
 
-            memcpy(data+k*skip*block,data2,skip*block);
+            _mm_storeu_si128((__m128i *)(plane[0]+r),_mm_packus_epi16(_mm_and_si128(a,m),_mm_and_si128(b,m)));
+            _mm_storeu_si128((__m128i *)(plane[1]+r),_mm_packus_epi16(_mm_srli_epi16(a,8),_mm_srli_epi16(b,8)));
             }
+         }
+      else if (skip==4)
+         {
+         __m128i m=_mm_set1_epi32(0xff);
 
-         for (ptr=data2,i=0; i<skip; i++)
-            for (j=i; j<bytes-k*skip*block; j+=skip) *ptr++=data[k*skip*block+j];
-
-         memcpy(data+k*skip*block,data2,bytes-k*skip*block);
+         for (; r+16<=n; r+=16)
+            {
+            __m128i a=_mm_loadu_si128((const __m128i *)(src+4*r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(src+4*r+16));
+            __m128i c=_mm_loadu_si128((const __m128i *)(src+4*r+32));
+            __m128i d=_mm_loadu_si128((const __m128i *)(src+4*r+48));
+
+            _mm_storeu_si128((__m128i *)(plane[0]+r),
+                             _mm_packus_epi16(_mm_packs_epi32(_mm_and_si128(a,m),_mm_and_si128(b,m)),
+                                              _mm_packs_epi32(_mm_and_si128(c,m),_mm_and_si128(d,m))));
+
+            a=_mm_srli_epi32(a,8);
+            b=_mm_srli_epi32(b,8);
+            c=_mm_srli_epi32(c,8);
+            d=_mm_srli_epi32(d,8);
+
+            _mm_storeu_si128((__m128i *)(plane[1]+r),
+                             _mm_packus_epi16(_mm_packs_epi32(_mm_and_si128(a,m),_mm_and_si128(b,m)),
+                                              _mm_packs_epi32(_mm_and_si128(c,m),_mm_and_si128(d,m))));
+
+            a=_mm_srli_epi32(a,8);
+            b=_mm_srli_epi32(b,8);
+            c=_mm_srli_epi32(c,8);
+            d=_mm_srli_epi32(d,8);
+
+            _mm_storeu_si128((__m128i *)(plane[2]+r),
+                             _mm_packus_epi16(_mm_packs_epi32(_mm_and_si128(a,m),_mm_and_si128(b,m)),
+                                              _mm_packs_epi32(_mm_and_si128(c,m),_mm_and_si128(d,m))));
+
+            _mm_storeu_si128((__m128i *)(plane[3]+r),
+                             _mm_packus_epi16(_mm_packs_epi32(_mm_srli_epi32(a,8),_mm_srli_epi32(b,8)),
+                                              _mm_packs_epi32(_mm_srli_epi32(c,8),_mm_srli_epi32(d,8))));
+            }
          }
-      else
+#endif
+
+#ifdef __SSSE3__
+      if (skip==3)
          {
-         for (k=0; k<bytes/skip/block; k++)
+         unsigned int q,k,t,s;
+
+         unsigned char shuffle[3][3][16];
+         __m128i mask[3][3];
+
+         // byte t of plane q is byte s=3*t+q of the 48 bytes of 16 records
+         for (q=0; q<3; q++)
+            for (k=0; k<3; k++)
+               {
+               for (t=0; t<16; t++)
+                  {
+                  s=3*t+q;
+                  shuffle[q][k][t]=(s/16==k)?s%16:0x80;
+                  }
+
+               mask[q][k]=_mm_loadu_si128((const __m128i *)shuffle[q][k]);
+               }
+
+         for (; r+16<=n; r+=16)
             {
-            for (ptr=data+k*skip*block,i=0; i<skip; i++)
-               for (j=i; j<skip*block; j+=skip) data2[j]=*ptr++;
+            __m128i a=_mm_loadu_si128((const __m128i *)(src+3*r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(src+3*r+16));
+            __m128i c=_mm_loadu_si128((const __m128i *)(src+3*r+32));
+
+            for (q=0; q<3; q++)
+               _mm_storeu_si128((__m128i *)(plane[q]+r),
+                                _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a,mask[q][0]),
+                                                          _mm_shuffle_epi8(b,mask[q][1])),
+                                             _mm_shuffle_epi8(c,mask[q][2])));
+            }
+         }
+#endif
+
+      for (i=0; i<skip; i++)
+         for (n=r; n*skip+i<bytes; n++) plane[i][n]=src[n*skip+i];
+      }
+   else
+      {
+      for (i=0; i<skip; i++) in[i]=src+start[i];
+
+#ifdef __SSE2__
+      if (skip==2)
+         for (; r+16<=n; r+=16)
+            {
+            __m128i a=_mm_loadu_si128((const __m128i *)(in[0]+r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(in[1]+r));
 
-            memcpy(data+k*skip*block,data2,skip*block);
+            _mm_storeu_si128((__m128i *)(dst+2*r),_mm_unpacklo_epi8(a,b));
+            _mm_storeu_si128((__m128i *)(dst+2*r+16),_mm_unpackhi_epi8(a,b));
             }
+      else if (skip==4)
+         for (; r+16<=n; r+=16)
+            {
+            __m128i a=_mm_loadu_si128((const __m128i *)(in[0]+r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(in[1]+r));
+            __m128i c=_mm_loadu_si128((const __m128i *)(in[2]+r));
+            __m128i d=_mm_loadu_si128((const __m128i *)(in[3]+r));
+
+            __m128i ab0=_mm_unpacklo_epi8(a,b),ab1=_mm_unpackhi_epi8(a,b);
+            __m128i cd0=_mm_unpacklo_epi8(c,d),cd1=_mm_unpackhi_epi8(c,d);
+
+            _mm_storeu_si128((__m128i *)(dst+4*r),_mm_unpacklo_epi16(ab0,cd0));
+            _mm_storeu_si128((__m128i *)(dst+4*r+16),_mm_unpackhi_epi16(ab0,cd0));
+            _mm_storeu_si128((__m128i *)(dst+4*r+32),_mm_unpacklo_epi16(ab1,cd1));
+            _mm_storeu_si128((__m128i *)(dst+4*r+48),_mm_unpackhi_epi16(ab1,cd1));
+            }
+#endif
+
+#ifdef __SSSE3__
+      if (skip==3)
+         {
+         unsigned int q,k,t,s;
 
-         for (ptr=data+k*skip*block,i=0; i<skip; i++)
-            for (j=i; j<bytes-k*skip*block; j+=skip) data2[j]=*ptr++;
+         unsigned char shuffle[3][3][16];
+         __m128i mask[3][3];
+
+         // byte s=16*k+t of the 48 bytes of 16 records is byte s/3 of plane s%3
+         for (q=0; q<3; q++)
+            for (k=0; k<3; k++)
+               {
+               for (t=0; t<16; t++)
+                  {
+                  s=16*k+t;
+                  shuffle[q][k][t]=(s%3==q)?s/3:0x80;
+                  }
+
+               mask[q][k]=_mm_loadu_si128((const __m128i *)shuffle[q][k]);
+               }
 
-         memcpy(data+k*skip*block,data2,bytes-k*skip*block);
+         for (; r+16<=n; r+=16)
+            {
+            __m128i a=_mm_loadu_si128((const __m128i *)(in[0]+r));
+            __m128i b=_mm_loadu_si128((const __m128i *)(in[1]+r));
+            __m128i c=_mm_loadu_si128((const __m128i *)(in[2]+r));
+
+            for (k=0; k<3; k++)
+               _mm_storeu_si128((__m128i *)(dst+3*r+16*k),
+                                _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a,mask[0][k]),
+                                                          _mm_shuffle_epi8(b,mask[1][k])),
+                                             _mm_shuffle_epi8(c,mask[2][k])));
+            }
          }
+#endif
+
+      for (i=0; i<skip; i++)
+         for (n=r; n*skip+i<bytes; n++) dst[n*skip+i]=in[i][n];
+      }
+   }
+
+// deinterleave a byte stream
+// * the stream is transposed from src to dst in tiles of skip*block bytes
+// * a block size of zero transposes the entire stream as a single tile
+void DDS_deinterleave(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip,unsigned int block=0,BOOLINT restore=FALSE)
+   {
+   unsigned int pos,tile;
+
+   if (skip<=1)
+      {
+      if (src!=dst) memcpy(dst,src,bytes);
+      return;
       }
 
-   free(data2);
+   tile=(block==0)?bytes:skip*block;
+
+   for (pos=0; pos<bytes; pos+=tile)
+      DDS_transpose(src+pos,dst+pos,(bytes-pos<tile)?bytes-pos:tile,skip,restore);
    }
 
 // interleave a byte stream
-void DDS_interleave(unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int block=0)
-   {DDS_deinterleave(data,bytes,skip,block,TRUE);}
+void DDS_interleave(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip,unsigned int block=0)
+   {DDS_deinterleave(src,dst,bytes,skip,block,TRUE);}
+
+// predict a range of a byte stream
+// * the deltas are stored in a ring buffer at the position of the value
+// * the first values are predicted from their predecessor only
+inline void DDS_predict(const unsigned char *data,unsigned int start,unsigned int end,unsigned int strip,
+                        unsigned char *delta)
+   {
+   unsigned int i;
+
+   for (i=start; i<end && (i==0 || strip==1 || i<=strip); i++)
+      delta[i%DDS_RING]=data[i]-((i>0)?data[i-1]:0);
+
+#ifdef __SSE2__
+   for (; i+16<=end && i%DDS_RING+16<=DDS_RING; i+=16)
+      {
+      __m128i v=_mm_sub_epi8(_mm_loadu_si128((const __m128i *)(data+i)),
+                             _mm_loadu_si128((const __m128i *)(data+i-1)));
+
+      if (strip>1)
+         v=_mm_add_epi8(_mm_sub_epi8(v,_mm_loadu_si128((const __m128i *)(data+i-strip))),
+                        _mm_loadu_si128((const __m128i *)(data+i-strip-1)));
+
+      _mm_storeu_si128((__m128i *)(delta+i%DDS_RING),v);
+      }
+#endif
+
+   for (; i<end; i++)
+      if (strip==1) delta[i%DDS_RING]=data[i]-data[i-1];
+      else delta[i%DDS_RING]=data[i]-data[i-1]-data[i-strip]+data[i-strip-1];
+   }
+
+// append a run of deltas to the bit stream
+// * four values are packed into a single write of up to 32 bits
+inline void DDS_writerun(DDS_context *ctx,const unsigned char *delta,unsigned int start,unsigned int cnt,unsigned int bits)
+   {
+   unsigned int i;
+
+   unsigned int half,mask,value;
+
+   DDS_writebits(ctx,cnt,DDS_RL);
+   DDS_writebits(ctx,DDS_code(bits),3);
+
+   if (bits==0) return;
+
+   half=(1<<bits)/2;
+   mask=(1<<bits)-1;
+
+   for (i=0; i+4<=cnt; i+=4)
+      {
+      value=(delta[(start+i)%DDS_RING]+half)&mask;
+      value=(value<<bits)|((delta[(start+i+1)%DDS_RING]+half)&mask);
+      value=(value<<bits)|((delta[(start+i+2)%DDS_RING]+half)&mask);
+      value=(value<<bits)|((delta[(start+i+3)%DDS_RING]+half)&mask);
+
+      DDS_writebits(ctx,value,4*bits);
+      }
+
+   for (; i<cnt; i++)
+      DDS_writebits(ctx,(delta[(start+i)%DDS_RING]+half)&mask,bits);
+   }
 
 // encode a Differential Data Stream
+// * the deltas of a batch of values are predicted at once into a ring buffer,
+//   which keeps them until their run is written
+// * a run of equal bit widths is merged with the pending run,
+//   if that is cheaper than writing both runs separately
 void DDS_encode(unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int strip,
                 unsigned char **chunk,unsigned int *size,
                 unsigned int block=0)
@@ -231,22 +508,32 @@ void DDS_encode(unsigned char *data,unsigned int bytes,unsigned int skip,unsigne
 
    unsigned char lookup[256];
 
-   unsigned char *ptr1,*ptr2;
+   unsigned char *planes;
 
-   int pre1,pre2,
-       act1,act2,
-       tmp1,tmp2;
+   unsigned char delta[DDS_RING];
 
-   unsigned int cnt,cnt1,cnt2;
+   unsigned int pos,start,end;
+   unsigned int cnt1,cnt2;
    int bits,bits1,bits2;
 
+   DDS_context ctx;
+
    if (bytes<1) ERRORMSG();
 
    if (skip<1 || skip>4) skip=1;
    if (strip<1 || strip>65536) strip=1;
 
-   DDS_deinterleave(data,bytes,skip,block);
+   // the records are split into planes in a scratch copy, so the data is left untouched
+   planes=NULL;
 
+   if (skip>1)
+      {
+      if ((planes=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+      DDS_deinterleave(data,planes,bytes,skip,block);
+      data=planes;
+      }
+
+   // the bit width of each delta byte
    for (i=-128; i<128; i++)
       {
       if (i<=0)
@@ -254,80 +541,64 @@ void DDS_encode(unsigned char *data,unsigned int bytes,unsigned int skip,unsigne
       else
          for (bits=0; (1<<bits)/2<=i; bits++);
 
-      lookup[i+128]=bits;
+      lookup[i&0xff]=DDS_decode(DDS_code(bits));
       }
 
-   DDS_initbuffer();
-
-   DDS_clearbits();
+   DDS_initbuffer(&ctx);
 
-   DDS_writebits(skip-1,2);
-   DDS_writebits(strip-1,16);
+   DDS_clearbits(&ctx);
 
-   ptr1=ptr2=data;
-   pre1=pre2=0;
+   // half of the data is reserved for the stream, which is grown geometrically beyond that
+   DDS_reservebits(&ctx,bytes/2+4);
 
-   cnt=cnt1=cnt2=0;
-   bits=bits1=bits2=0;
+   DDS_writebits(&ctx,skip-1,2);
+   DDS_writebits(&ctx,strip-1,16);
 
-   while (cnt++<bytes)
-      {
-      tmp1=*ptr1;
-      if (strip==1 || ptr1-strip<=data) act1=tmp1-pre1;
-      else act1=tmp1-pre1-*(ptr1-strip)+*(ptr1-strip-1);
-      pre1=tmp1;
-      ptr1++;
-
-      while (act1<-128) act1+=256;
-      while (act1>127) act1-=256;
+   start=0;
 
-      bits=lookup[act1+128];
+   cnt1=cnt2=0;
+   bits1=bits2=0;
 
-      bits=DDS_decode(DDS_code(bits));
+   for (pos=0; pos<bytes; pos=end)
+      {
+      end=(bytes-pos<DDS_BATCH)?bytes:pos+DDS_BATCH;
 
-      if (cnt1==0)
-         {
-         cnt1++;
-         bits1=bits;
-         continue;
-         }
+      DDS_predict(data,pos,end,strip,delta);
 
-      if (cnt1<(1<<DDS_RL)-1 && bits==bits1)
+      for (; pos<end; pos++)
          {
-         cnt1++;
-         continue;
-         }
+         bits=lookup[delta[pos%DDS_RING]];
 
-      if (cnt1+cnt2<(1<<DDS_RL) && (cnt1+cnt2)*max(bits1,bits2)<cnt1*bits1+cnt2*bits2+DDS_RL+3)
-         {
-         cnt2+=cnt1;
-         if (bits1>bits2) bits2=bits1;
-         }
-      else
-         {
-         DDS_writebits(cnt2,DDS_RL);
-         DDS_writebits(DDS_code(bits2),3);
+         if (cnt1==0)
+            {
+            cnt1++;
+            bits1=bits;
+            continue;
+            }
 
-         while (cnt2-->0)
+         if (cnt1<(1<<DDS_RL)-1 && bits==bits1)
             {
-            tmp2=*ptr2;
-            if (strip==1 || ptr2-strip<=data) act2=tmp2-pre2;
-            else act2=tmp2-pre2-*(ptr2-strip)+*(ptr2-strip-1);
-            pre2=tmp2;
-            ptr2++;
+            cnt1++;
+            continue;
+            }
 
-            while (act2<-128) act2+=256;
-            while (act2>127) act2-=256;
+         if (cnt1+cnt2<(1<<DDS_RL) && (cnt1+cnt2)*max(bits1,bits2)<cnt1*bits1+cnt2*bits2+DDS_RL+3)
+            {
+            cnt2+=cnt1;
+            if (bits1>bits2) bits2=bits1;
+            }
+         else
+            {
+            DDS_writerun(&ctx,delta,start,cnt2,bits2);
+            start+=cnt2;
 
-            DDS_writebits(act2+(1<<bits2)/2,bits2);
+            cnt2=cnt1;
+            bits2=bits1;
             }
 
-         cnt2=cnt1;
-         bits2=bits1;
+         cnt1=1;
+         bits1=bits;
          }
-
-      cnt1=1;
-      bits1=bits;
       }
 
    if (cnt1+cnt2<(1<<DDS_RL) && (cnt1+cnt2)*max(bits1,bits2)<cnt1*bits1+cnt2*bits2+DDS_RL+3)
@@ -337,430 +608,1858 @@ void DDS_encode(unsigned char *data,unsigned int bytes,unsigned int skip,unsigne
       }
    else
       {
-      DDS_writebits(cnt2,DDS_RL);
-      DDS_writebits(DDS_code(bits2),3);
-
-      while (cnt2-->0)
-         {
-         tmp2=*ptr2;
-         if (strip==1 || ptr2-strip<=data) act2=tmp2-pre2;
-         else act2=tmp2-pre2-*(ptr2-strip)+*(ptr2-strip-1);
-         pre2=tmp2;
-         ptr2++;
-
-         while (act2<-128) act2+=256;
-         while (act2>127) act2-=256;
-
-         DDS_writebits(act2+(1<<bits2)/2,bits2);
-         }
+      DDS_writerun(&ctx,delta,start,cnt2,bits2);
+      start+=cnt2;
 
       cnt2=cnt1;
       bits2=bits1;
       }
 
-   if (cnt2!=0)
-      {
-      DDS_writebits(cnt2,DDS_RL);
-      DDS_writebits(DDS_code(bits2),3);
-
-      while (cnt2-->0)
-         {
-         tmp2=*ptr2;
-         if (strip==1 || ptr2-strip<=data) act2=tmp2-pre2;
-         else act2=tmp2-pre2-*(ptr2-strip)+*(ptr2-strip-1);
-         pre2=tmp2;
-         ptr2++;
-
-         while (act2<-128) act2+=256;
-         while (act2>127) act2-=256;
-
-         DDS_writebits(act2+(1<<bits2)/2,bits2);
-         }
-      }
+   if (cnt2!=0) DDS_writerun(&ctx,delta,start,cnt2,bits2);
 
-   DDS_flushbits();
-   DDS_savebits(chunk,size);
+   DDS_flushbits(&ctx);
+   DDS_savebits(&ctx,chunk,size);
 
-   DDS_interleave(data,bytes,skip,block);
+   free(planes);
    }
 
 // decode a Differential Data Stream
+// * the decoded stream grows geometrically beyond the reserved size
+// * with an output buffer the stream is decoded into the output,
+//   which must hold the reserved size
 void DDS_decode(unsigned char *chunk,unsigned int size,
                 unsigned char **data,unsigned int *bytes,
-                unsigned int block=0)
+                unsigned int block=0,
+                unsigned int reserve=0,unsigned char *output=NULL)
    {
    unsigned int skip,strip;
 
    unsigned char *ptr1,*ptr2;
 
-   unsigned int cnt,cnt1,cnt2;
-   int bits,act;
+   unsigned int cnt,cnt1,cnt2,maxcnt;
+   unsigned int first,i,n;
+   int bits,half,act;
+
+   DDS_context ctx;
 
-   DDS_initbuffer();
+   DDS_initbuffer(&ctx);
 
-   DDS_clearbits();
-   DDS_loadbits(chunk,size);
+   DDS_clearbits(&ctx);
+   DDS_loadbits(&ctx,chunk,size);
 
-   skip=DDS_readbits(2)+1;
-   strip=DDS_readbits(16)+1;
+   skip=DDS_readbits(&ctx,2)+1;
+   strip=DDS_readbits(&ctx,16)+1;
 
-   ptr1=ptr2=NULL;
-   cnt=act=0;
+   // the first values are predicted from their predecessor only
+   first=(strip==1)?~0u:strip+1;
 
-   while ((cnt1=DDS_readbits(DDS_RL))!=0)
+   ptr1=NULL;
+   cnt=maxcnt=0;
+   act=0;
+
+   // a single plane is decoded straight into the output, records are merged from a scratch copy
+   if (output!=NULL && skip==1) ptr1=output;
+   else if (reserve>0)
+      if ((ptr1=(unsigned char *)malloc(reserve))==NULL) ERRORMSG();
+
+   if (ptr1!=NULL) maxcnt=reserve;
+
+   while ((cnt1=DDS_readbits(&ctx,DDS_RL))!=0)
       {
-      bits=DDS_decode(DDS_readbits(3));
+      bits=DDS_decode(DDS_readbits(&ctx,3));
+      half=(1<<bits)/2;
+
+      // reserve the output of the entire run
+      if (cnt+cnt1>maxcnt)
+         {
+         if (output!=NULL || maxcnt==0xffffffffu) ERRORMSG();
+
+         maxcnt=DDS_grow(maxcnt);
+         if ((ptr1=(unsigned char *)realloc(ptr1,maxcnt))==NULL) ERRORMSG();
+         }
+
+      ptr2=&ptr1[cnt];
 
-      for (cnt2=0; cnt2<cnt1; cnt2++)
+      // unpack as many values of the run as the refilled bit buffer holds
+      for (cnt2=cnt1; cnt2>0; cnt2-=n)
          {
-         if (strip==1 || cnt<=strip) act+=DDS_readbits(bits)-(1<<bits)/2;
-         else act+=*(ptr2-strip)-*(ptr2-strip-1)+DDS_readbits(bits)-(1<<bits)/2;
+         DDS_refill(&ctx);
 
-         while (act<0) act+=256;
-         while (act>255) act-=256;
+         n=(bits>0)?ctx.bitcnt/bits:cnt2;
+         if (n>cnt2) n=cnt2;
 
-         if ((cnt&(DDS_BLOCKSIZE-1))==0)
+         for (i=0; i<n; i++,cnt++)
             {
-            if (ptr1==NULL)
-               {
-               if ((ptr1=(unsigned char *)malloc(DDS_BLOCKSIZE))==NULL) ERRORMSG();
-               ptr2=ptr1;
-               }
-            else
-               {
-               if ((ptr1=(unsigned char *)realloc(ptr1,cnt+DDS_BLOCKSIZE))==NULL) ERRORMSG();
-               ptr2=&ptr1[cnt];
-               }
-            }
+            act+=(int)DDS_takebits(&ctx,bits)-half;
+            if (cnt>=first) act+=*(ptr2-strip)-*(ptr2-strip-1);
+
+            act&=0xff;
 
-         *ptr2++=act;
-         cnt++;
+            *ptr2++=act;
+            }
          }
       }
 
-   if (ptr1!=NULL)
-      if ((ptr1=(unsigned char *)realloc(ptr1,cnt))==NULL) ERRORMSG();
+   // an empty stream has no output
+   if (cnt==0 && ptr1!=output)
+      {
+      free(ptr1);
+      ptr1=NULL;
+      }
+
+   // the planes are merged back into records in a copy of the exact size
+   if (ptr1!=NULL && ptr1!=output)
+      {
+      if (skip>1)
+         {
+         if (output!=NULL) ptr2=output;
+         else if ((ptr2=(unsigned char *)malloc(cnt))==NULL) ERRORMSG();
+
+         DDS_interleave(ptr1,ptr2,cnt,skip,block);
 
-   DDS_interleave(ptr1,cnt,skip,block);
+         free(ptr1);
+         ptr1=ptr2;
+         }
+      else if (cnt<maxcnt)
+         {
+         if ((ptr1=(unsigned char *)realloc(ptr1,cnt))==NULL) ERRORMSG();
+         }
+      }
 
    *data=ptr1;
    *bytes=cnt;
    }
 
-// write a RAW file
-void writeRAWfile(const char *filename,unsigned char *data,unsigned int bytes,BOOLINT nofree)
+// delta filter of a byte stream
+// * applies the DDS predictor to the deinterleaved stream,
+//   so that a byte coder sees the small residuals instead of the values
+// * the first values are predicted from their predecessor only
+void DDS_filter(const unsigned char *data,unsigned char *residual,unsigned int bytes,unsigned int skip,unsigned int strip)
    {
-   FILE *file;
-
-   if (bytes<1) ERRORMSG();
+   unsigned int i;
 
-   if ((file=fopen(filename,"wb"))==NULL) ERRORMSG();
-   if (fwrite(data,1,bytes,file)!=bytes) ERRORMSG();
+   DDS_deinterleave(data,residual,bytes,skip);
 
-   fclose(file);
+   // the residuals are computed back to front, so the predecessors are still intact
+   if (strip>1)
+      for (i=bytes-1; i>strip; i--)
+         residual[i]=residual[i]-residual[i-1]-residual[i-strip]+residual[i-strip-1];
 
-   if (!nofree) free(data);
+   for (i=(strip>1 && bytes>strip+1)?strip+1:bytes; i>1; i--)
+      residual[i-1]-=residual[i-2];
    }
 
-// read from a RAW file
-unsigned char *readRAWfiled(FILE *file,unsigned int *bytes)
+// inverse delta filter of a byte stream
+// * the residuals are restored in place and then interleaved into the data
+// * the predecessor is carried in a register, so the loop does not wait for its own stores
+void DDS_unfilter(unsigned char *residual,unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int strip)
    {
-   unsigned char *data;
-   unsigned int cnt,blkcnt;
+   unsigned int i;
 
-   data=NULL;
-   cnt=0;
+   unsigned char act;
 
-   do
+   for (act=0,i=0; i<bytes && (strip==1 || i<=strip); i++)
+      residual[i]=act+=residual[i];
+
+#ifdef __SSE2__
+   // 16 values are restored at once by a prefix sum,
+   // if the row above does not overlap with them
+   if (strip==1 || strip>=16)
       {
-      if (data==NULL)
-         {if ((data=(unsigned char *)malloc(DDS_BLOCKSIZE))==NULL) ERRORMSG();}
-      else
-         if ((data=(unsigned char *)realloc(data,cnt+DDS_BLOCKSIZE))==NULL) ERRORMSG();
+      __m128i v,carry=_mm_set1_epi8(act);
 
-      blkcnt=fread(&data[cnt],1,DDS_BLOCKSIZE,file);
-      cnt+=blkcnt;
+      for (; i+16<=bytes; i+=16)
+         {
+         v=_mm_loadu_si128((const __m128i *)(residual+i));
+
+         if (strip>1)
+            v=_mm_sub_epi8(_mm_add_epi8(v,_mm_loadu_si128((const __m128i *)(residual+i-strip))),
+                           _mm_loadu_si128((const __m128i *)(residual+i-strip-1)));
+
+         v=_mm_add_epi8(v,_mm_slli_si128(v,1));
+         v=_mm_add_epi8(v,_mm_slli_si128(v,2));
+         v=_mm_add_epi8(v,_mm_slli_si128(v,4));
+         v=_mm_add_epi8(v,_mm_slli_si128(v,8));
+         v=_mm_add_epi8(v,carry);
+
+         _mm_storeu_si128((__m128i *)(residual+i),v);
+
+         // the last value is broadcast as the carry of the next 16 values
+         carry=_mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_unpackhi_epi8(v,v),0xff),0xff);
+         }
+
+      if (i>0) act=residual[i-1];
       }
-   while (blkcnt==DDS_BLOCKSIZE);
+#endif
 
-   if (cnt==0)
+   for (; i<bytes; i++)
+      if (strip==1) residual[i]=act+=residual[i];
+      else residual[i]=act+=residual[i]+residual[i-strip]-residual[i-strip-1];
+
+   DDS_interleave(residual,data,bytes,skip);
+   }
+
+// fetch four bytes in native byte order
+inline unsigned int DDS_getraw(const unsigned char *ptr)
+   {
+   unsigned int value;
+   memcpy(&value,ptr,4);
+   return(value);
+   }
+
+// append a sequence of literals and a match to an LZ4 block
+// * a match length of zero denotes the last sequence, which holds literals only
+inline void DDS_putLZ4(unsigned char **ptr,const unsigned char *literals,unsigned int lit,unsigned int offset,unsigned int len)
+   {
+   unsigned char *out=*ptr;
+   unsigned int n,m;
+
+   m=(len>0)?len-4:0;
+
+   *out++=((lit<15?lit:15)<<4)|(m<15?m:15);
+
+   if (lit>=15)
       {
-      free(data);
-      return(NULL);
+      for (n=lit-15; n>=255; n-=255) *out++=255;
+      *out++=n;
       }
 
-   if ((data=(unsigned char *)realloc(data,cnt))==NULL) ERRORMSG();
+   memcpy(out,literals,lit);
+   out+=lit;
 
-   *bytes=cnt;
+   if (len>0)
+      {
+      *out++=offset&0xff;
+      *out++=offset>>8;
 
-   return(data);
+      if (m>=15)
+         {
+         for (n=m-15; n>=255; n-=255) *out++=255;
+         *out++=n;
+         }
+      }
+
+   *ptr=out;
    }
 
-// read a RAW file
-unsigned char *readRAWfile(const char *filename,unsigned int *bytes)
+// encode a byte stream in the LZ4 block format
+// * greedy parser with a hash table of 4-byte sequences
+// * the last match ends 5 bytes and starts 12 bytes before the end of the stream
+void DDS_encodeLZ4(const unsigned char *data,unsigned int bytes,unsigned char **chunk,unsigned int *size)
    {
-   FILE *file;
+   const unsigned int hashbits=16;
 
-   unsigned char *data;
+   unsigned int *table;
 
-   if ((file=fopen(filename,"rb"))==NULL) return(NULL);
+   unsigned char *ptr;
 
-   data=readRAWfiled(file,bytes);
+   unsigned int i,anchor,limit,step;
+   unsigned int cand,len;
 
-   fclose(file);
+   if ((*chunk=(unsigned char *)malloc(bytes+bytes/255+16))==NULL) ERRORMSG();
+   if ((table=(unsigned int *)malloc((1<<hashbits)*sizeof(unsigned int)))==NULL) ERRORMSG();
 
-   return(data);
+   memset(table,0,(1<<hashbits)*sizeof(unsigned int));
+
+   ptr=*chunk;
+
+   anchor=0;
+   limit=(bytes>12)?bytes-12:0;
+
+   for (i=0,step=64; i<limit;)
+      {
+      unsigned int &entry=table[(DDS_getraw(data+i)*2654435761u)>>(32-hashbits)];
+
+      cand=entry;
+      entry=i;
+
+      // without a match the search advances faster the longer it fails
+      if (cand>=i || i-cand>65535 || DDS_getraw(data+cand)!=DDS_getraw(data+i))
+         {
+         i+=step++>>6;
+         continue;
+         }
+
+      for (len=4; i+len<bytes-5 && data[cand+len]==data[i+len]; len++);
+      for (; i>anchor && cand>0 && data[i-1]==data[cand-1]; i--,cand--) len++;
+
+      DDS_putLZ4(&ptr,data+anchor,i-anchor,i-cand,len);
+
+      i+=len;
+      anchor=i;
+
+      step=64;
+      }
+
+   DDS_putLZ4(&ptr,data+anchor,bytes-anchor,0,0);
+
+   free(table);
+
+   *size=ptr-*chunk;
+   }
+
+// decode a byte stream in the LZ4 block format
+// * the stream must decode to exactly the given number of bytes
+// * returns FALSE if the stream is corrupt
+BOOLINT DDS_decodeLZ4(const unsigned char *chunk,unsigned int size,unsigned char *data,unsigned int bytes)
+   {
+   const unsigned char *ip,*iend,*match;
+   unsigned char *op,*oend;
+
+   unsigned int token,lit,len,offset,s,i;
+
+   ip=chunk;
+   iend=chunk+size;
+
+   op=data;
+   oend=data+bytes;
+
+   while (ip<iend)
+      {
+      token=*ip++;
+
+      if ((lit=token>>4)==15)
+         do
+            {
+            if (ip>=iend) return(FALSE);
+            lit+=s=*ip++;
+            }
+         while (s==255);
+
+      if (lit>(unsigned int)(iend-ip) || lit>(unsigned int)(oend-op)) return(FALSE);
+
+      // short literals are copied at once, if there is room for a full copy
+      if (lit<=16 && iend-ip>=16 && oend-op>=16) memcpy(op,ip,16);
+      else memcpy(op,ip,lit);
+
+      ip+=lit;
+      op+=lit;
+
+      if (ip==iend) break;
+
+      if (iend-ip<2) return(FALSE);
+
+      offset=ip[0]|(ip[1]<<8);
+      ip+=2;
+
+      if (offset==0 || offset>(unsigned int)(op-data)) return(FALSE);
+
+      if ((len=token&15)==15)
+         do
+            {
+            if (ip>=iend) return(FALSE);
+            len+=s=*ip++;
+            }
+         while (s==255);
+
+      len+=4;
+
+      if (len>(unsigned int)(oend-op)) return(FALSE);
+
+      match=op-offset;
+
+      // distant matches are copied in pieces of 16 bytes, which may overshoot the match
+      if (offset>=16 && len+16<=(unsigned int)(oend-op))
+         for (i=0; i<len; i+=16) memcpy(op+i,match+i,16);
+      else
+         for (i=0; i<len; i++) op[i]=match[i];
+
+      op+=len;
+      }
+
+   return(op==oend);
+   }
+
+// write a RAW file
+void writeRAWfile(const char *filename,unsigned char *data,long long bytes,BOOLINT nofree)
+   {
+   FILE *file;
+
+   if (bytes<1) ERRORMSG();
+
+   if ((file=fopen(filename,"wb"))==NULL) ERRORMSG();
+   if (fwrite(data,1,bytes,file)!=(size_t)bytes) ERRORMSG();
+
+   fclose(file);
+
+   if (!nofree) free(data);
+   }
+
+// read from a RAW file
+// * the data grows geometrically, so it is reallocated only log(n) times
+unsigned char *readRAWfiled(FILE *file,long long *bytes)
+   {
+   unsigned char *data;
+   long long cnt,size,blkcnt;
+
+   data=NULL;
+   cnt=size=0;
+
+   do
+      {
+      if (cnt==size)
+         {
+         size=(size<DDS_BLOCKSIZE)?DDS_BLOCKSIZE:2*size;
+         if ((data=(unsigned char *)realloc(data,size))==NULL) ERRORMSG();
+         }
+
+      blkcnt=fread(&data[cnt],1,size-cnt,file);
+      cnt+=blkcnt;
+      }
+   while (blkcnt>0);
+
+   if (cnt==0)
+      {
+      free(data);
+      return(NULL);
+      }
+
+   if ((data=(unsigned char *)realloc(data,cnt))==NULL) ERRORMSG();
+
+   *bytes=cnt;
+
+   return(data);
+   }
+
+// read a RAW file
+unsigned char *readRAWfile(const char *filename,long long *bytes)
+   {
+   FILE *file;
+
+   unsigned char *data;
+
+   if ((file=fopen(filename,"rb"))==NULL) return(NULL);
+
+   data=readRAWfiled(file,bytes);
+
+   fclose(file);
+
+   return(data);
+   }
+
+// read a RAW file with less than 4GB
+unsigned char *readRAWfile(const char *filename,unsigned int *bytes)
+   {
+   unsigned char *data;
+   long long cnt;
+
+   if ((data=readRAWfile(filename,&cnt))==NULL) return(NULL);
+
+   if (cnt>0xffffffffLL)
+      {
+      free(data);
+      return(NULL);
+      }
+
+   *bytes=cnt;
+
+   return(data);
+   }
+
+// size of an open file in bytes
+// * the file position is rewound to the start of the file
+long long DDS_filesize(FILE *file)
+   {
+   long long size;
+
+#ifndef _WIN32
+   fseeko(file,0,SEEK_END);
+   size=ftello(file);
+   fseeko(file,0,SEEK_SET);
+#else
+   _fseeki64(file,0,SEEK_END);
+   size=_ftelli64(file);
+   _fseeki64(file,0,SEEK_SET);
+#endif
+
+   return(size);
+   }
+
+// store an unsigned int in big endian byte order
+inline void DDS_putuint(unsigned char *ptr,unsigned int value)
+   {
+   ptr[0]=value>>24;
+   ptr[1]=(value>>16)&0xff;
+   ptr[2]=(value>>8)&0xff;
+   ptr[3]=value&0xff;
+   }
+
+// fetch an unsigned int in big endian byte order
+inline unsigned int DDS_getuint(const unsigned char *ptr)
+   {return(((unsigned int)ptr[0]<<24)|((unsigned int)ptr[1]<<16)|((unsigned int)ptr[2]<<8)|ptr[3]);}
+
+// determine the version of a DDS file from its id
+// * returns 0 if the id is not a known DDS id
+int DDS_version(const char *id)
+   {
+   if (strncmp(id,DDS_ID,strlen(DDS_ID))==0) return(1);
+   if (strncmp(id,DDS_ID2,strlen(DDS_ID2))==0) return(2);
+   if (strncmp(id,DDS_ID3,strlen(DDS_ID3))==0) return(3);
+   if (strncmp(id,DDS_ID4,strlen(DDS_ID4))==0) return(4);
+   if (strncmp(id,DDS_ID5,strlen(DDS_ID5))==0) return(5);
+
+   return(0);
+   }
+
+// byte coders of the DDS container
+// * the classic DDS coder has no entry, it is not a byte coder
+static DDS_encoder DDS_encoders[DDS_CODECS]={NULL,DDS_encodeLZ4};
+static DDS_decoder DDS_decoders[DDS_CODECS]={NULL,DDS_decodeLZ4};
+
+// register a byte coder of the DDS container
+// * the built-in codecs can be replaced, except for the classic DDS coder
+// * the registry is not synchronized, so codecs must be registered at initialization,
+//   before any DDS file is written or read
+void registerDDScodec(unsigned int codec,DDS_encoder encode,DDS_decoder decode)
+   {
+   if (codec==DDS_CODEC_DDS || codec>=DDS_CODECS) ERRORMSG();
+
+   DDS_encoders[codec]=encode;
+   DDS_decoders[codec]=decode;
+   }
+
+// check whether a codec can be encoded
+inline BOOLINT DDS_encodable(unsigned int codec)
+   {return(codec==DDS_CODEC_DDS || (codec<DDS_CODECS && DDS_encoders[codec]!=NULL));}
+
+// check whether a codec can be decoded
+inline BOOLINT DDS_decodable(unsigned int codec)
+   {return(codec==DDS_CODEC_DDS || (codec<DDS_CODECS && DDS_decoders[codec]!=NULL));}
+
+// encode a chunk with a codec
+// * a byte coder codes the delta filtered chunk,
+//   the filter parameters are stored in front of the coded residuals
+void DDS_encodechunk(unsigned int codec,unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int strip,
+                     unsigned char **chunk,unsigned int *size)
+   {
+   unsigned char *residual,*coded;
+   unsigned int cnt;
+
+   if (codec==DDS_CODEC_DDS)
+      {
+      DDS_encode(data,bytes,skip,strip,chunk,size);
+      return;
+      }
+
+   if ((residual=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   DDS_filter(data,residual,bytes,skip,strip);
+   DDS_encoders[codec](residual,bytes,&coded,&cnt);
+
+   free(residual);
+
+   if ((*chunk=(unsigned char *)malloc(cnt+3))==NULL) ERRORMSG();
+
+   (*chunk)[0]=skip-1;
+   (*chunk)[1]=(strip-1)>>8;
+   (*chunk)[2]=(strip-1)&0xff;
+
+   memcpy(*chunk+3,coded,cnt);
+   free(coded);
+
+   *size=cnt+3;
+   }
+
+// decode a chunk with a codec
+// * the chunk must decode to exactly the given number of bytes
+// * the chunk is decoded into the output buffer if one is given
+void DDS_decodechunk(unsigned int codec,unsigned char *chunk,unsigned int size,
+                     unsigned char **data,unsigned int bytes,
+                     unsigned char *output=NULL)
+   {
+   unsigned int skip,strip;
+
+   unsigned char *residual;
+   unsigned int cnt;
+
+   if (codec==DDS_CODEC_DDS)
+      {
+      DDS_decode(chunk,size,data,&cnt,0,bytes,output);
+      if (cnt!=bytes) ERRORMSG();
+      return;
+      }
+
+   if (size<3 || bytes<1) ERRORMSG();
+
+   skip=chunk[0]+1;
+   strip=((chunk[1]<<8)|chunk[2])+1;
+
+   if (skip>4) ERRORMSG();
+
+   // a single plane is restored in place
+   if (skip==1 && output!=NULL) residual=output;
+   else if ((residual=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   if (!DDS_decoders[codec](chunk+3,size-3,residual,bytes)) ERRORMSG();
+
+   if (skip==1) *data=residual;
+   else if (output!=NULL) *data=output;
+   else if ((*data=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   DDS_unfilter(residual,*data,bytes,skip,strip);
+
+   if (skip>1) free(residual);
+   }
+
+// number of available cores
+inline unsigned int DDS_threads()
+   {
+   unsigned int threads=std::thread::hardware_concurrency();
+   return((threads<1)?1:threads);
+   }
+
+// run a job for each chunk of a stream on all available cores
+// * or on the given number of threads
+// * the chunks are handed out in order
+template <class F>
+void DDS_parallel(unsigned int chunks,F job,unsigned int threads=0)
+   {
+   unsigned int i;
+
+   std::atomic<unsigned int> next(0);
+   std::vector<std::thread> workers;
+
+   if (threads==0) threads=DDS_threads();
+   if (threads>chunks) threads=chunks;
+
+   auto worker=[&]()
+      {
+      unsigned int c;
+      while ((c=next++)<chunks) job(c);
+      };
+
+   for (i=1; i<threads; i++) workers.push_back(std::thread(worker));
+   worker();
+
+   for (i=0; i<workers.size(); i++) workers[i].join();
+   }
+
+// streaming writer of a Differential Data Stream
+// * the stream is passed to the writer in pieces of arbitrary size
+// * streams larger than a chunk are split into independently coded chunks,
+//   which are compressed in parallel one batch at a time,
+//   so only a batch of chunks is held in memory
+// * streams of 4GB and more are written in the large format,
+//   which records the size of the stream in front of the chunk table
+// * streams coded with a byte coder are always chunked and written in the codec format,
+//   which records the codec and the size of the stream in front of the chunk table
+struct DDS_writer
+   {
+   FILE *file;
+
+   unsigned int codec,skip,strip;
+
+   unsigned long long total,written; // announced and received size of the stream
+
+   unsigned int chunks,chunk,chunksize; // chunk table
+   unsigned char *table;
+   unsigned int tableoffset;
+
+   unsigned char *batch; // stream data of the current batch of chunks
+   unsigned long long batchsize,batchfill;
+   };
+
+// open a streaming DDS writer for a stream of the given size
+DDS_writer *DDS_openwriter(const char *filename,unsigned long long total,unsigned int skip,unsigned int strip,unsigned int codec)
+   {
+   DDS_writer *writer;
+
+   unsigned char size[8];
+   int i;
+
+   if (total<1) ERRORMSG();
+   if (!DDS_encodable(codec)) ERRORMSG();
+
+   if ((writer=(DDS_writer *)malloc(sizeof(DDS_writer)))==NULL) ERRORMSG();
+   memset(writer,0,sizeof(DDS_writer));
+
+   if ((writer->file=fopen(filename,"wb"))==NULL) ERRORMSG();
+
+   if (skip<1 || skip>4) skip=1;
+   if (strip<1 || strip>65536) strip=1;
+
+   writer->codec=codec;
+   writer->skip=skip;
+   writer->strip=strip;
+
+   writer->total=total;
+
+   // a small stream is coded as a single stream
+   if (codec==DDS_CODEC_DDS && total<=DDS_CHUNKSIZE)
+      {
+      fprintf(writer->file,"%s",DDS_ID);
+
+      writer->batchsize=total;
+      }
+   else
+      {
+      // the chunks hold whole rows of skip*strip bytes, so the predictor stays aligned
+      writer->chunksize=DDS_CHUNKSIZE/(skip*strip)*(skip*strip);
+      writer->chunks=(total+writer->chunksize-1)/writer->chunksize;
+
+      if (codec==DDS_CODEC_DDS && total<=0xffffffffULL) fprintf(writer->file,"%s",DDS_ID3);
+      else
+         {
+         if (codec==DDS_CODEC_DDS) fprintf(writer->file,"%s",DDS_ID4);
+         else
+            {
+            fprintf(writer->file,"%s",DDS_ID5);
+
+            DDS_putuint(size,codec);
+            if (fwrite(size,4,1,writer->file)!=1) ERRORMSG();
+            }
+
+         for (i=0; i<8; i++) size[i]=(total>>(56-8*i))&0xff;
+         if (fwrite(size,8,1,writer->file)!=1) ERRORMSG();
+         }
+
+      // the chunk table is reserved and written when the writer is closed
+      writer->tableoffset=ftell(writer->file);
+
+      if ((writer->table=(unsigned char *)malloc(4+8*(unsigned long long)writer->chunks))==NULL) ERRORMSG();
+      memset(writer->table,0,4+8*(unsigned long long)writer->chunks);
+
+      DDS_putuint(writer->table,writer->chunks);
+
+      if (fwrite(writer->table,4+8*(unsigned long long)writer->chunks,1,writer->file)!=1) ERRORMSG();
+
+      writer->batchsize=(unsigned long long)DDS_threads()*writer->chunksize;
+      if (writer->batchsize>total) writer->batchsize=total;
+      }
+
+   if ((writer->batch=(unsigned char *)malloc(writer->batchsize))==NULL) ERRORMSG();
+
+   return(writer);
+   }
+
+// encode a batch of chunks in parallel and append them to the stream
+void DDS_writebatch(DDS_writer *writer,unsigned char *data,unsigned long long bytes)
+   {
+   unsigned int c,n;
+
+   unsigned char **chunk;
+   unsigned int *size;
+
+   n=(bytes+writer->chunksize-1)/writer->chunksize;
+
+   if ((chunk=(unsigned char **)malloc(n*sizeof(unsigned char *)))==NULL) ERRORMSG();
+   if ((size=(unsigned int *)malloc(n*sizeof(unsigned int)))==NULL) ERRORMSG();
+
+   DDS_parallel(n,[&](unsigned int k)
+      {
+      unsigned int raw=(k<n-1)?writer->chunksize:bytes-(unsigned long long)k*writer->chunksize;
+      DDS_encodechunk(writer->codec,data+(unsigned long long)k*writer->chunksize,raw,writer->skip,writer->strip,&chunk[k],&size[k]);
+      });
+
+   for (c=0; c<n; c++)
+      {
+      if (writer->chunk>=writer->chunks) ERRORMSG();
+
+      DDS_putuint(writer->table+4+8*(unsigned long long)writer->chunk,(c<n-1)?writer->chunksize:bytes-(unsigned long long)c*writer->chunksize);
+      DDS_putuint(writer->table+8+8*(unsigned long long)writer->chunk,size[c]);
+
+      writer->chunk++;
+
+      if (fwrite(chunk[c],size[c],1,writer->file)!=1) ERRORMSG();
+      free(chunk[c]);
+      }
+
+   free(chunk);
+   free(size);
+   }
+
+// pass the next piece of the stream to a DDS writer
+void DDS_writestream(DDS_writer *writer,unsigned char *data,unsigned long long bytes)
+   {
+   unsigned long long n;
+
+   if (bytes>writer->total-writer->written) ERRORMSG();
+   writer->written+=bytes;
+
+   while (bytes>0)
+      {
+      // whole batches are coded in place
+      if (writer->batchfill==0 && writer->chunks>0 && bytes>=writer->batchsize)
+         {
+         DDS_writebatch(writer,data,writer->batchsize);
+
+         data+=writer->batchsize;
+         bytes-=writer->batchsize;
+
+         continue;
+         }
+
+      n=writer->batchsize-writer->batchfill;
+      if (n>bytes) n=bytes;
+
+      memcpy(writer->batch+writer->batchfill,data,n);
+      writer->batchfill+=n;
+
+      data+=n;
+      bytes-=n;
+
+      if (writer->batchfill==writer->batchsize && writer->chunks>0)
+         {
+         DDS_writebatch(writer,writer->batch,writer->batchfill);
+         writer->batchfill=0;
+         }
+      }
+   }
+
+// close a DDS writer
+void DDS_closewriter(DDS_writer *writer)
+   {
+   unsigned char *chunk;
+   unsigned int size;
+
+   if (writer->written!=writer->total) ERRORMSG();
+
+   if (writer->chunks==0)
+      {
+      DDS_encode(writer->batch,writer->batchfill,writer->skip,writer->strip,&chunk,&size);
+
+      if (chunk!=NULL)
+         {
+         if (fwrite(chunk,size,1,writer->file)!=1) ERRORMSG();
+         free(chunk);
+         }
+      }
+   else
+      {
+      if (writer->batchfill>0) DDS_writebatch(writer,writer->batch,writer->batchfill);
+      if (writer->chunk!=writer->chunks) ERRORMSG();
+
+      if (fseek(writer->file,writer->tableoffset,SEEK_SET)!=0) ERRORMSG();
+      if (fwrite(writer->table,4+8*(unsigned long long)writer->chunks,1,writer->file)!=1) ERRORMSG();
+
+      free(writer->table);
+      }
+
+   if (fclose(writer->file)!=0) ERRORMSG();
+
+   free(writer->batch);
+   free(writer);
+   }
+
+// read the chunk table of a chunked DDS file
+// * the table holds the raw and the coded size of each chunk in big endian order
+// * the large format records the size of the stream in front of the table
+// * the codec format records the codec in front of the size
+// * returns FALSE if the codec is unknown
+BOOLINT DDS_readtable(FILE *file,int version,
+                      unsigned int *codec,
+                      unsigned int *chunks,unsigned int **raw,unsigned int **coded,
+                      unsigned long long *total)
+   {
+   unsigned char table[8];
+
+   unsigned long long size;
+   unsigned int i;
+
+   size=0;
+
+   *codec=DDS_CODEC_DDS;
+
+   if (version==5)
+      {
+      if (fread(table,4,1,file)!=1) ERRORMSG();
+      *codec=DDS_getuint(table);
+
+      if (!DDS_decodable(*codec)) return(FALSE);
+      }
+
+   if (version>=4)
+      {
+      if (fread(table,8,1,file)!=1) ERRORMSG();
+      for (i=0; i<8; i++) size=(size<<8)|table[i];
+      }
+
+   if (fread(table,4,1,file)!=1) ERRORMSG();
+   *chunks=DDS_getuint(table);
+   if (*chunks<1) ERRORMSG();
+
+   if ((*raw=(unsigned int *)malloc(*chunks*sizeof(unsigned int)))==NULL) ERRORMSG();
+   if ((*coded=(unsigned int *)malloc(*chunks*sizeof(unsigned int)))==NULL) ERRORMSG();
+
+   *total=0;
+
+   for (i=0; i<*chunks; i++)
+      {
+      if (fread(table,8,1,file)!=1) ERRORMSG();
+
+      (*raw)[i]=DDS_getuint(table);
+      (*coded)[i]=DDS_getuint(table+4);
+
+      *total+=(*raw)[i];
+      }
+
+   if (version==3 && *total>0xffffffffULL) ERRORMSG();
+   if (version>=4 && *total!=size) ERRORMSG();
+
+   return(TRUE);
+   }
+
+// read and decode a batch of chunks in parallel
+// * each decoded chunk is returned as a separate piece
+// * with an output buffer the chunks are decoded one after the other into the output
+void DDS_readbatch(FILE *file,unsigned int codec,unsigned int n,const unsigned int *raw,const unsigned int *coded,
+                   unsigned char **piece,
+                   unsigned char *output=NULL)
+   {
+   unsigned int i;
+
+   unsigned char *chunk;
+   unsigned long long size;
+
+   for (size=0,i=0; i<n; i++) size+=coded[i];
+
+   if ((chunk=(unsigned char *)malloc(size))==NULL) ERRORMSG();
+   if (fread(chunk,1,size,file)!=size) ERRORMSG();
+
+   DDS_parallel(n,[&](unsigned int k)
+      {
+      unsigned int j;
+      unsigned long long offset,pos;
+
+      unsigned char *ptr;
+
+      for (offset=pos=0,j=0; j<k; j++)
+         {
+         offset+=coded[j];
+         pos+=raw[j];
+         }
+
+      DDS_decodechunk(codec,chunk+offset,coded[k],output?&ptr:&piece[k],raw[k],output?output+pos:NULL);
+      });
+
+   free(chunk);
+   }
+
+// read and decode all chunks of a chunked DDS file into the output
+// * the chunks are decoded in place, so the output is neither grown nor copied
+void DDS_readchunks(FILE *file,unsigned int codec,unsigned int chunks,const unsigned int *raw,const unsigned int *coded,
+                    unsigned char *output)
+   {
+   unsigned int c,i,n;
+
+   n=DDS_threads();
+
+   for (c=0; c<chunks; c+=n)
+      {
+      if (n>chunks-c) n=chunks-c;
+
+      DDS_readbatch(file,codec,n,raw+c,coded+c,NULL,output);
+
+      for (i=0; i<n; i++) output+=raw[c+i];
+      }
+   }
+
+// write a Differential Data Stream
+// * other codecs than the classic DDS coder are written in the codec format,
+//   which cannot be read by older versions
+void writeDDSfile(const char *filename,unsigned char *data,long long bytes,unsigned int skip,unsigned int strip,BOOLINT nofree,
+                  unsigned int codec)
+   {
+   DDS_writer *writer;
+
+   if (bytes<1) ERRORMSG();
+
+   writer=DDS_openwriter(filename,bytes,skip,strip,codec);
+   DDS_writestream(writer,data,bytes);
+   DDS_closewriter(writer);
+
+   if (!nofree) free(data);
+   }
+
+// read a Differential Data Stream
+// * a chunked stream is decoded one batch of chunks at a time,
+//   so only the decoded stream and a batch of chunks are held in memory
+unsigned char *readDDSfile(const char *filename,long long *bytes)
+   {
+   int version;
+
+   FILE *file;
+
+   char id[sizeof(DDS_ID)];
+
+   unsigned char *chunk,*data;
+   long long size;
+   unsigned int cnt;
+
+   unsigned int codec,chunks,*raw,*coded;
+   unsigned long long total;
+
+   if ((file=fopen(filename,"rb"))==NULL) return(NULL);
+
+   if (fread(id,strlen(DDS_ID),1,file)!=1)
+      {
+      fclose(file);
+      return(NULL);
+      }
+
+   if ((version=DDS_version(id))==0)
+      {
+      fclose(file);
+      return(NULL);
+      }
+
+   if (version<3)
+      {
+      if ((chunk=readRAWfiled(file,&size))==NULL) ERRORMSG();
+      if (size>0xffffffffLL) ERRORMSG();
+
+      DDS_decode(chunk,size,&data,&cnt,version==1?0:DDS_INTERLEAVE);
+      free(chunk);
+
+      *bytes=cnt;
+      }
+   else
+      {
+      if (!DDS_readtable(file,version,&codec,&chunks,&raw,&coded,&total))
+         {
+         fclose(file);
+         return(NULL);
+         }
+
+      if ((data=(unsigned char *)malloc(total))==NULL) ERRORMSG();
+
+      DDS_readchunks(file,codec,chunks,raw,coded,data);
+
+      free(raw);
+      free(coded);
+
+      *bytes=total;
+      }
+
+   fclose(file);
+
+   return(data);
+   }
+
+// read a Differential Data Stream with less than 4GB
+unsigned char *readDDSfile(const char *filename,unsigned int *bytes)
+   {
+   unsigned char *data;
+   long long cnt;
+
+   if ((data=readDDSfile(filename,&cnt))==NULL) return(NULL);
+
+   if (cnt>0xffffffffLL)
+      {
+      free(data);
+      return(NULL);
+      }
+
+   *bytes=cnt;
+
+   return(data);
+   }
+
+// decode a Differential Data Stream into a RAW file
+// * the chunks are decoded straight into the mapped output file,
+//   so the decoded stream is never held on the heap
+// * a compressed PVM volume is extracted into an uncompressed PVM volume, which can be mapped
+// * returns FALSE if the file is not a DDS file or the output cannot be mapped
+BOOLINT extractDDSfile(const char *filename,const char *output,long long *bytes)
+   {
+   int version;
+
+   FILE *file;
+
+   char id[sizeof(DDS_ID)];
+
+   unsigned char *chunk,*data;
+   long long size;
+   unsigned int cnt;
+
+   unsigned int codec,chunks,*raw,*coded;
+   unsigned long long total;
+
+   if ((file=fopen(filename,"rb"))==NULL) return(FALSE);
+
+   if (fread(id,strlen(DDS_ID),1,file)!=1)
+      {
+      fclose(file);
+      return(FALSE);
+      }
+
+   if ((version=DDS_version(id))==0)
+      {
+      fclose(file);
+      return(FALSE);
+      }
+
+   // a single stream is decoded on the heap, since its size is not known in advance
+   if (version<3)
+      {
+      if ((chunk=readRAWfiled(file,&size))==NULL) ERRORMSG();
+      if (size>0xffffffffLL) ERRORMSG();
+
+      DDS_decode(chunk,size,&data,&cnt,version==1?0:DDS_INTERLEAVE);
+      free(chunk);
+
+      fclose(file);
+
+      writeRAWfile(output,data,cnt);
+      if (bytes!=NULL) *bytes=cnt;
+
+      return(TRUE);
+      }
+
+   if (!DDS_readtable(file,version,&codec,&chunks,&raw,&coded,&total))
+      {
+      fclose(file);
+      return(FALSE);
+      }
+
+   if (total<1) ERRORMSG();
+
+#ifndef _WIN32
+
+   int fd;
+
+   if ((fd=open(output,O_RDWR|O_CREAT|O_TRUNC,0666))<0)
+      {
+      fclose(file);
+      free(raw);
+      free(coded);
+      return(FALSE);
+      }
+
+   if (ftruncate(fd,total)!=0 ||
+       (data=(unsigned char *)mmap(NULL,total,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0))==MAP_FAILED)
+      {
+      close(fd);
+      fclose(file);
+      free(raw);
+      free(coded);
+      return(FALSE);
+      }
+
+   close(fd);
+
+   DDS_readchunks(file,codec,chunks,raw,coded,data);
+
+   if (munmap(data,total)!=0) ERRORMSG();
+
+#else
+
+   HANDLE out,map;
+
+   if ((out=CreateFileA(output,GENERIC_READ|GENERIC_WRITE,0,NULL,CREATE_ALWAYS,FILE_ATTRIBUTE_NORMAL,NULL))==INVALID_HANDLE_VALUE)
+      {
+      fclose(file);
+      free(raw);
+      free(coded);
+      return(FALSE);
+      }
+
+   if ((map=CreateFileMappingA(out,NULL,PAGE_READWRITE,(DWORD)(total>>32),(DWORD)(total&0xffffffff),NULL))==NULL)
+      {
+      CloseHandle(out);
+      fclose(file);
+      free(raw);
+      free(coded);
+      return(FALSE);
+      }
+
+   data=(unsigned char *)MapViewOfFile(map,FILE_MAP_WRITE,0,0,0);
+
+   CloseHandle(map);
+
+   if (data==NULL)
+      {
+      CloseHandle(out);
+      fclose(file);
+      free(raw);
+      free(coded);
+      return(FALSE);
+      }
+
+   DDS_readchunks(file,codec,chunks,raw,coded,data);
+
+   if (!UnmapViewOfFile(data)) ERRORMSG();
+   CloseHandle(out);
+
+#endif
+
+   fclose(file);
+
+   free(raw);
+   free(coded);
+
+   if (bytes!=NULL) *bytes=total;
+
+   return(TRUE);
+   }
+
+void swapshort(unsigned char *ptr,unsigned int size)
+   {
+   unsigned int i;
+
+   unsigned char lo,hi;
+
+   for (i=0; i<size; i++)
+      {
+      lo=ptr[0];
+      hi=ptr[1];
+      *ptr++=hi;
+      *ptr++=lo;
+      }
+   }
+
+// write an optionally compressed PNM image
+void writePNMimage(const char *filename,unsigned char *image,unsigned int width,unsigned int height,unsigned int components,BOOLINT dds)
+   {
+   char str[DDS_MAXSTR];
+
+   unsigned char *data;
+
+   if (width<1 || height<1) ERRORMSG();
+
+   switch (components)
+      {
+      case 1: snprintf(str,DDS_MAXSTR,"P5\n%d %d\n255\n",width,height); break;
+      case 2: snprintf(str,DDS_MAXSTR,"P5\n%d %d\n32767\n",width,height); break;
+      case 3: snprintf(str,DDS_MAXSTR,"P6\n%d %d\n255\n",width,height); break;
+      default: ERRORMSG();
+      }
+
+   if ((data=(unsigned char *)malloc(strlen(str)+width*height*components))==NULL) ERRORMSG();
+
+   memcpy(data,str,strlen(str));
+   memcpy(data+strlen(str),image,width*height*components);
+
+   if (dds) writeDDSfile(filename,data,strlen(str)+width*height*components,components,width);
+   else writeRAWfile(filename,data,strlen(str)+width*height*components);
+   }
+
+// read a possibly compressed PNM image
+unsigned char *readPNMimage(const char *filename,unsigned int *width,unsigned int *height,unsigned int *components)
+   {
+   const int maxstr=100;
+
+   char str[maxstr];
+
+   unsigned char *data,*ptr1,*ptr2;
+   unsigned int bytes;
+
+   int pnmtype,maxval;
+   unsigned char *image;
+
+   if ((data=readDDSfile(filename,&bytes))==NULL)
+      if ((data=readRAWfile(filename,&bytes))==NULL) return(NULL);
+
+   if (bytes<4) return(NULL);
+
+   memcpy(str,data,3);
+   str[3]='\0';
+
+   if (sscanf(str,"P%1d\n",&pnmtype)!=1) return(NULL);
+
+   ptr1=data+3;
+   while (*ptr1=='\n' || *ptr1=='#')
+      {
+      while (*ptr1=='\n')
+         if (++ptr1>=data+bytes) ERRORMSG();
+      while (*ptr1=='#')
+         if (++ptr1>=data+bytes) ERRORMSG();
+         else
+            while (*ptr1!='\n')
+               if (++ptr1>=data+bytes) ERRORMSG();
+      }
+
+   ptr2=ptr1;
+   while (*ptr2!='\n' && *ptr2!=' ')
+      if (++ptr2>=data+bytes) ERRORMSG();
+   if (++ptr2>=data+bytes) ERRORMSG();
+   while (*ptr2!='\n' && *ptr2!=' ')
+      if (++ptr2>=data+bytes) ERRORMSG();
+   if (++ptr2>=data+bytes) ERRORMSG();
+   while (*ptr2!='\n' && *ptr2!=' ')
+      if (++ptr2>=data+bytes) ERRORMSG();
+   if (++ptr2>=data+bytes) ERRORMSG();
+
+   if (ptr2-ptr1>=maxstr) ERRORMSG();
+   memcpy(str,ptr1,ptr2-ptr1);
+   str[ptr2-ptr1]='\0';
+
+   if (sscanf(str,"%d %d\n%d\n",width,height,&maxval)!=3) ERRORMSG();
+
+   if (*width<1 || *height<1) ERRORMSG();
+
+   if (pnmtype==5 && maxval==255) *components=1;
+   else if (pnmtype==5 && (maxval==32767 || maxval==65535)) *components=2;
+   else if (pnmtype==6 && maxval==255) *components=3;
+   else ERRORMSG();
+
+   if ((image=(unsigned char *)malloc((*width)*(*height)*(*components)))==NULL) ERRORMSG();
+   if (data+bytes!=ptr2+(*width)*(*height)*(*components)) ERRORMSG();
+
+   memcpy(image,ptr2,(*width)*(*height)*(*components));
+   free(data);
+
+   return(image);
+   }
+
+// write a compressed PVM volume
+// * the volume is either given in memory or produced slice by slice by a callback
+// * the stream is passed to a streaming DDS writer, so the volume is not copied
+void PVM_write(const char *filename,unsigned char *volume,
+               void (*slice)(unsigned char *data,unsigned int z,void *user),void *user,
+               unsigned int width,unsigned int height,unsigned int depth,unsigned int components,
+               float scalex,float scaley,float scalez,
+               unsigned char *description,
+               unsigned char *courtesy,
+               unsigned char *parameter,
+               unsigned char *comment,
+               unsigned int codec)
+   {
+   char str[DDS_MAXSTR];
+
+   DDS_writer *writer;
+
+   unsigned char *data;
+   unsigned long long bytes;
+   unsigned int z;
+
+   unsigned char zero=0;
+
+   unsigned int len1=1,len2=1,len3=1,len4=1;
+
+   if (width<1 || height<1 || depth<1 || components<1) ERRORMSG();
+
+   if (description==NULL && courtesy==NULL && parameter==NULL && comment==NULL)
+      if (scalex==1.0f && scaley==1.0f && scalez==1.0f)
+         snprintf(str,DDS_MAXSTR,"PVM\n%u %u %u\n%u\n",width,height,depth,components);
+      else
+         snprintf(str,DDS_MAXSTR,"PVM2\n%u %u %u\n%g %g %g\n%u\n",width,height,depth,scalex,scaley,scalez,components);
+   else
+      {
+      snprintf(str,DDS_MAXSTR,"PVM3\n%u %u %u\n%g %g %g\n%u\n",width,height,depth,scalex,scaley,scalez,components);
+
+      if (description!=NULL) len1=strlen((char *)description)+1;
+      if (courtesy!=NULL) len2=strlen((char *)courtesy)+1;
+      if (parameter!=NULL) len3=strlen((char *)parameter)+1;
+      if (comment!=NULL) len4=strlen((char *)comment)+1;
+      }
+
+   bytes=(unsigned long long)width*height*components;
+
+   writer=DDS_openwriter(filename,strlen(str)+bytes*depth+
+                         ((strncmp(str,"PVM3\n",5)==0)?len1+len2+len3+len4:0),
+                         components,width,codec);
+
+   DDS_writestream(writer,(unsigned char *)str,strlen(str));
+
+   if (volume!=NULL) DDS_writestream(writer,volume,bytes*depth);
+   else
+      {
+      if ((data=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+      for (z=0; z<depth; z++)
+         {
+         slice(data,z,user);
+         DDS_writestream(writer,data,bytes);
+         }
+
+      free(data);
+      }
+
+   if (strncmp(str,"PVM3\n",5)==0)
+      {
+      DDS_writestream(writer,(description==NULL)?&zero:description,len1);
+      DDS_writestream(writer,(courtesy==NULL)?&zero:courtesy,len2);
+      DDS_writestream(writer,(parameter==NULL)?&zero:parameter,len3);
+      DDS_writestream(writer,(comment==NULL)?&zero:comment,len4);
+      }
+
+   DDS_closewriter(writer);
+   }
+
+// write a compressed PVM volume
+void writePVMvolume(const char *filename,unsigned char *volume,
+                    unsigned int width,unsigned int height,unsigned int depth,unsigned int components,
+                    float scalex,float scaley,float scalez,
+                    unsigned char *description,
+                    unsigned char *courtesy,
+                    unsigned char *parameter,
+                    unsigned char *comment,
+                    unsigned int codec)
+   {
+   PVM_write(filename,volume,NULL,NULL,
+             width,height,depth,components,
+             scalex,scaley,scalez,
+             description,courtesy,parameter,comment,
+             codec);
+   }
+
+// write a compressed PVM volume slice by slice
+// * the slice callback fills in the voxels of a slice
+// * just a single slice and a batch of chunks are held in memory
+void writePVMslices(const char *filename,
+                    void (*slice)(unsigned char *data,unsigned int z,void *user),void *user,
+                    unsigned int width,unsigned int height,unsigned int depth,unsigned int components,
+                    float scalex,float scaley,float scalez,
+                    unsigned char *description,
+                    unsigned char *courtesy,
+                    unsigned char *parameter,
+                    unsigned char *comment,
+                    unsigned int codec)
+   {
+   PVM_write(filename,NULL,slice,user,
+             width,height,depth,components,
+             scalex,scaley,scalez,
+             description,courtesy,parameter,comment,
+             codec);
+   }
+
+// state of a streamed PVM volume
+// * the decoded stream is produced in pieces: a block of a RAW file,
+//   the whole stream of a single-stream DDS file or a batch of chunks of a chunked DDS file
+struct PVMstream
+   {
+   FILE *file;
+
+   int version; // DDS version or 0 for a RAW file
+
+   unsigned int codec,chunks,chunk; // chunk table of a chunked DDS file
+   unsigned int *raw,*coded;
+
+   unsigned char **piece; // decoded pieces
+   unsigned int *piecesize;
+   unsigned int pieces,current,piecepos;
+
+   unsigned long long total,pos; // size of and position in the decoded stream
+
+   int pvmversion;
+   unsigned int width,height,depth,components;
+   float scalex,scaley,scalez;
+   };
+
+// release the decoded pieces of a PVM stream
+void PVM_freepieces(PVMstream *stream)
+   {
+   unsigned int i;
+
+   for (i=0; i<stream->pieces; i++) free(stream->piece[i]);
+
+   free(stream->piece);
+   free(stream->piecesize);
+
+   stream->piece=NULL;
+   stream->piecesize=NULL;
+   stream->pieces=stream->current=stream->piecepos=0;
+   }
+
+// decode the next pieces of a PVM stream
+// * returns FALSE at the end of the stream
+BOOLINT PVM_loadpieces(PVMstream *stream)
+   {
+   unsigned int i,n;
+
+   unsigned char *chunk,*ptr;
+   unsigned int size;
+   long long coded;
+
+   PVM_freepieces(stream);
+
+   if (stream->version==0)
+      {
+      if ((ptr=(unsigned char *)malloc(DDS_CHUNKSIZE))==NULL) ERRORMSG();
+
+      if ((size=fread(ptr,1,DDS_CHUNKSIZE,stream->file))==0)
+         {
+         free(ptr);
+         return(FALSE);
+         }
+
+      n=1;
+      }
+   else if (stream->version<3)
+      {
+      if (stream->chunk++>0) return(FALSE);
+
+      if ((chunk=readRAWfiled(stream->file,&coded))==NULL) ERRORMSG();
+      if (coded>0xffffffffLL) ERRORMSG();
+
+      DDS_decode(chunk,coded,&ptr,&size,stream->version==1?0:DDS_INTERLEAVE);
+      free(chunk);
+
+      n=1;
+      }
+   else
+      {
+      if (stream->chunk>=stream->chunks) return(FALSE);
+
+      // a batch of chunks is decoded in parallel
+      n=DDS_threads();
+      if (n>stream->chunks-stream->chunk) n=stream->chunks-stream->chunk;
+
+      if ((stream->piece=(unsigned char **)malloc(n*sizeof(unsigned char *)))==NULL) ERRORMSG();
+      if ((stream->piecesize=(unsigned int *)malloc(n*sizeof(unsigned int)))==NULL) ERRORMSG();
+
+      DDS_readbatch(stream->file,stream->codec,n,stream->raw+stream->chunk,stream->coded+stream->chunk,stream->piece);
+
+      for (i=0; i<n; i++) stream->piecesize[i]=stream->raw[stream->chunk+i];
+
+      stream->chunk+=n;
+      stream->pieces=n;
+
+      return(TRUE);
+      }
+
+   if ((stream->piece=(unsigned char **)malloc(sizeof(unsigned char *)))==NULL) ERRORMSG();
+   if ((stream->piecesize=(unsigned int *)malloc(sizeof(unsigned int)))==NULL) ERRORMSG();
+
+   stream->piece[0]=ptr;
+   stream->piecesize[0]=size;
+   stream->pieces=n;
+
+   return(TRUE);
+   }
+
+// fetch bytes from a PVM stream
+// * the bytes are skipped if data is NULL
+void PVM_fetch(PVMstream *stream,unsigned char *data,unsigned long long bytes)
+   {
+   unsigned long long n;
+
+   while (bytes>0)
+      {
+      if (stream->current>=stream->pieces)
+         if (!PVM_loadpieces(stream)) ERRORMSG();
+
+      n=stream->piecesize[stream->current]-stream->piecepos;
+      if (n>bytes) n=bytes;
+
+      if (data!=NULL)
+         {
+         memcpy(data,stream->piece[stream->current]+stream->piecepos,n);
+         data+=n;
+         }
+
+      stream->piecepos+=n;
+      stream->pos+=n;
+      bytes-=n;
+
+      if (stream->piecepos>=stream->piecesize[stream->current])
+         {
+         stream->current++;
+         stream->piecepos=0;
+         }
+      }
    }
 
-// write a Differential Data Stream
-void writeDDSfile(const char *filename,unsigned char *data,unsigned int bytes,unsigned int skip,unsigned int strip,BOOLINT nofree)
+// parse the header of a PVM volume
+// * returns the length of the header or 0 if the data is not a PVM volume
+unsigned int PVM_parseheader(const unsigned char *data,unsigned int bytes,
+                             int *version,
+                             unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components,
+                             float *scalex,float *scaley,float *scalez)
    {
-   int version=1;
-
-   FILE *file;
+   char *header,*ptr;
+   unsigned int len;
 
-   unsigned char *chunk;
-   unsigned int size;
-
-   if (bytes<1) ERRORMSG();
+   if (bytes>DDS_MAXHEADER) bytes=DDS_MAXHEADER;
+   if (bytes<5) return(0);
 
-   if (bytes>DDS_INTERLEAVE) version=2;
+   if ((header=(char *)malloc(bytes+1))==NULL) ERRORMSG();
+   memcpy(header,data,bytes);
+   header[bytes]='\0';
 
-   if ((file=fopen(filename,"wb"))==NULL) ERRORMSG();
-   fprintf(file,"%s",(version==1)?DDS_ID:DDS_ID2);
+   *version=1;
+   *scalex=*scaley=*scalez=1.0f;
 
-   DDS_encode(data,bytes,skip,strip,&chunk,&size,version==1?0:DDS_INTERLEAVE);
+   if (strncmp(header,"PVM\n",4)!=0)
+      {
+      if (strncmp(header,"PVM2\n",5)==0) *version=2;
+      else if (strncmp(header,"PVM3\n",5)==0) *version=3;
+      else
+         {
+         free(header);
+         return(0);
+         }
 
-   if (chunk!=NULL)
+      ptr=&header[5];
+      if (sscanf(ptr,"%d %d %d\n%g %g %g\n",width,height,depth,scalex,scaley,scalez)!=6) ERRORMSG();
+      if (*width<1 || *height<1 || *depth<1 || *scalex<=0.0f || *scaley<=0.0f || *scalez<=0.0f) ERRORMSG();
+      if ((ptr=strchr(ptr,'\n'))==NULL) ERRORMSG();
+      ptr++;
+      }
+   else
       {
-      if (fwrite(chunk,size,1,file)!=1) ERRORMSG();
-      free(chunk);
+      ptr=&header[4];
+      while (*ptr=='#')
+         while (*ptr++!='\n')
+            if (*ptr=='\0') ERRORMSG();
+
+      if (sscanf(ptr,"%d %d %d\n",width,height,depth)!=3) ERRORMSG();
+      if (*width<1 || *height<1 || *depth<1) ERRORMSG();
       }
 
-   fclose(file);
+   if ((ptr=strchr(ptr,'\n'))==NULL) ERRORMSG();
+   ptr++;
+   if (sscanf(ptr,"%d\n",components)!=1) ERRORMSG();
+   if (*components<1) ERRORMSG();
+   if ((ptr=strchr(ptr,'\n'))==NULL) ERRORMSG();
+   ptr++;
 
-   if (!nofree) free(data);
+   len=ptr-header;
+   free(header);
+
+   return(len);
    }
 
-// read a Differential Data Stream
-unsigned char *readDDSfile(const char *filename,unsigned int *bytes)
+// open a PVM volume for streaming
+// * parses the header of the volume, but does not decode the voxels yet
+// * returns NULL if the file is not a PVM volume
+PVMstream *openPVMvolume(const char *filename,
+                         unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components,
+                         float *scalex,float *scaley,float *scalez)
    {
-   int version=1;
+   PVMstream *stream;
 
-   FILE *file;
+   char id[sizeof(DDS_ID)];
 
-   int cnt;
+   unsigned int len;
 
-   unsigned char *chunk,*data;
-   unsigned int size;
+   if ((stream=(PVMstream *)malloc(sizeof(PVMstream)))==NULL) ERRORMSG();
+   memset(stream,0,sizeof(PVMstream));
 
-   if ((file=fopen(filename,"rb"))==NULL) return(NULL);
+   if ((stream->file=fopen(filename,"rb"))==NULL)
+      {
+      free(stream);
+      return(NULL);
+      }
+
+   // determine the stream type
+   if (fread(id,strlen(DDS_ID),1,stream->file)!=1) stream->version=0;
+   else stream->version=DDS_version(id);
 
-   for (cnt=0; DDS_ID[cnt]!='\0'; cnt++)
-      if (fgetc(file)!=DDS_ID[cnt])
+   if (stream->version==0) stream->total=DDS_filesize(stream->file);
+   else if (stream->version>=3)
+      if (!DDS_readtable(stream->file,stream->version,&stream->codec,&stream->chunks,&stream->raw,&stream->coded,&stream->total))
          {
-         fclose(file);
-         version=0;
-         break;
+         closePVMvolume(stream);
+         return(NULL);
          }
 
-   if (version==0)
+   // the header is contained in the first piece
+   if (!PVM_loadpieces(stream))
       {
-      if ((file=fopen(filename,"rb"))==NULL) return(NULL);
-
-      for (cnt=0; DDS_ID2[cnt]!='\0'; cnt++)
-         if (fgetc(file)!=DDS_ID2[cnt])
-            {
-            fclose(file);
-            return(NULL);
-            }
-
-      version=2;
+      closePVMvolume(stream);
+      return(NULL);
       }
 
-   if ((chunk=readRAWfiled(file,&size))==NULL) ERRORMSG();
+   if (stream->version==1 || stream->version==2) stream->total=stream->piecesize[0];
 
-   fclose(file);
+   if ((len=PVM_parseheader(stream->piece[0],stream->piecesize[0],
+                            &stream->pvmversion,
+                            &stream->width,&stream->height,&stream->depth,&stream->components,
+                            &stream->scalex,&stream->scaley,&stream->scalez))==0)
+      {
+      closePVMvolume(stream);
+      return(NULL);
+      }
 
-   DDS_decode(chunk,size,&data,bytes,version==1?0:DDS_INTERLEAVE);
+   if (components==NULL && stream->components!=1) ERRORMSG();
 
-   free(chunk);
+   PVM_fetch(stream,NULL,len);
 
-   return(data);
-   }
+   if (stream->total-stream->pos<(unsigned long long)stream->width*stream->height*stream->depth*stream->components) ERRORMSG();
 
-void swapshort(unsigned char *ptr,unsigned int size)
-   {
-   unsigned int i;
+   *width=stream->width;
+   *height=stream->height;
+   *depth=stream->depth;
 
-   unsigned char lo,hi;
+   if (components!=NULL) *components=stream->components;
 
-   for (i=0; i<size; i++)
+   if (scalex!=NULL && scaley!=NULL && scalez!=NULL)
       {
-      lo=ptr[0];
-      hi=ptr[1];
-      *ptr++=hi;
-      *ptr++=lo;
+      *scalex=stream->scalex;
+      *scaley=stream->scaley;
+      *scalez=stream->scalez;
       }
+
+   return(stream);
    }
 
-// write an optionally compressed PNM image
-void writePNMimage(const char *filename,unsigned char *image,unsigned int width,unsigned int height,unsigned int components,BOOLINT dds)
+// decode the voxels of a streamed PVM volume slice by slice
+// * the slices are decoded into the volume, if it is not NULL
+// * the slice callback is called as soon as a slice is complete
+// * without a volume, the slices are only passed to the callback
+//   and just a single slice is held in memory
+void readPVMslices(PVMstream *stream,unsigned char *volume,
+                   void (*slice)(unsigned char *data,unsigned int z,void *user),void *user)
    {
-   char str[DDS_MAXSTR];
+   unsigned int z;
 
    unsigned char *data;
+   unsigned long long bytes;
 
-   if (width<1 || height<1) ERRORMSG();
+   bytes=(unsigned long long)stream->width*stream->height*stream->components;
 
-   switch (components)
+   if (volume!=NULL) data=volume;
+   else if ((data=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   for (z=0; z<stream->depth; z++)
       {
-      case 1: snprintf(str,DDS_MAXSTR,"P5\n%d %d\n255\n",width,height); break;
-      case 2: snprintf(str,DDS_MAXSTR,"P5\n%d %d\n32767\n",width,height); break;
-      case 3: snprintf(str,DDS_MAXSTR,"P6\n%d %d\n255\n",width,height); break;
-      default: ERRORMSG();
+      PVM_fetch(stream,data,bytes);
+      if (slice!=NULL) slice(data,z,user);
+
+      if (volume!=NULL) data+=bytes;
       }
 
-   if ((data=(unsigned char *)malloc(strlen(str)+width*height*components))==NULL) ERRORMSG();
+   if (volume==NULL) free(data);
+   }
 
-   memcpy(data,str,strlen(str));
-   memcpy(data+strlen(str),image,width*height*components);
+// close a streamed PVM volume
+void closePVMvolume(PVMstream *stream)
+   {
+   PVM_freepieces(stream);
 
-   if (dds) writeDDSfile(filename,data,strlen(str)+width*height*components,components,width);
-   else writeRAWfile(filename,data,strlen(str)+width*height*components);
+   free(stream->raw);
+   free(stream->coded);
+
+   fclose(stream->file);
+   free(stream);
    }
 
-// read a possibly compressed PNM image
-unsigned char *readPNMimage(const char *filename,unsigned int *width,unsigned int *height,unsigned int *components)
+// map an uncompressed PVM volume into memory
+// * the voxels are accessed directly in the page cache, nothing is read or copied up front
+// * the mapping is copy-on-write, so the voxels can be modified without changing the file
+// * the access hint tells the kernel whether to read ahead or not
+// * returns NULL if the file is compressed, not a PVM volume or cannot be mapped
+PVMmapping *mapPVMvolume(const char *filename,BOOLINT random)
    {
-   const int maxstr=100;
-
-   char str[maxstr];
+   PVMmapping *mapping;
 
-   unsigned char *data,*ptr1,*ptr2;
-   unsigned int bytes;
+   unsigned long long size,voxels;
+   unsigned int len;
 
-   int pnmtype,maxval;
-   unsigned char *image;
+   unsigned char *base;
 
-   if ((data=readDDSfile(filename,&bytes))==NULL)
-      if ((data=readRAWfile(filename,&bytes))==NULL) return(NULL);
+   if ((mapping=(PVMmapping *)malloc(sizeof(PVMmapping)))==NULL) ERRORMSG();
+   memset(mapping,0,sizeof(PVMmapping));
 
-   if (bytes<4) return(NULL);
+#ifndef _WIN32
 
-   memcpy(str,data,3);
-   str[3]='\0';
+   int fd;
+   struct stat st;
 
-   if (sscanf(str,"P%1d\n",&pnmtype)!=1) return(NULL);
+   if ((fd=open(filename,O_RDONLY))<0)
+      {
+      free(mapping);
+      return(NULL);
+      }
 
-   ptr1=data+3;
-   while (*ptr1=='\n' || *ptr1=='#')
+   if (fstat(fd,&st)!=0 || st.st_size<1)
       {
-      while (*ptr1=='\n')
-         if (++ptr1>=data+bytes) ERRORMSG();
-      while (*ptr1=='#')
-         if (++ptr1>=data+bytes) ERRORMSG();
-         else
-            while (*ptr1!='\n')
-               if (++ptr1>=data+bytes) ERRORMSG();
+      close(fd);
+      free(mapping);
+      return(NULL);
       }
 
-   ptr2=ptr1;
-   while (*ptr2!='\n' && *ptr2!=' ')
-      if (++ptr2>=data+bytes) ERRORMSG();
-   if (++ptr2>=data+bytes) ERRORMSG();
-   while (*ptr2!='\n' && *ptr2!=' ')
-      if (++ptr2>=data+bytes) ERRORMSG();
-   if (++ptr2>=data+bytes) ERRORMSG();
-   while (*ptr2!='\n' && *ptr2!=' ')
-      if (++ptr2>=data+bytes) ERRORMSG();
-   if (++ptr2>=data+bytes) ERRORMSG();
+   size=st.st_size;
 
-   if (ptr2-ptr1>=maxstr) ERRORMSG();
-   memcpy(str,ptr1,ptr2-ptr1);
-   str[ptr2-ptr1]='\0';
+   if ((base=(unsigned char *)mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0))==MAP_FAILED)
+      {
+      close(fd);
+      free(mapping);
+      return(NULL);
+      }
 
-   if (sscanf(str,"%d %d\n%d\n",width,height,&maxval)!=3) ERRORMSG();
+   close(fd);
 
-   if (*width<1 || *height<1) ERRORMSG();
+#else
 
-   if (pnmtype==5 && maxval==255) *components=1;
-   else if (pnmtype==5 && (maxval==32767 || maxval==65535)) *components=2;
-   else if (pnmtype==6 && maxval==255) *components=3;
-   else ERRORMSG();
+   HANDLE file,map;
+   LARGE_INTEGER st;
 
-   if ((image=(unsigned char *)malloc((*width)*(*height)*(*components)))==NULL) ERRORMSG();
-   if (data+bytes!=ptr2+(*width)*(*height)*(*components)) ERRORMSG();
+   if ((file=CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+                         random?FILE_FLAG_RANDOM_ACCESS:FILE_FLAG_SEQUENTIAL_SCAN,NULL))==INVALID_HANDLE_VALUE)
+      {
+      free(mapping);
+      return(NULL);
+      }
 
-   memcpy(image,ptr2,(*width)*(*height)*(*components));
-   free(data);
+   if (!GetFileSizeEx(file,&st) || st.QuadPart<1)
+      {
+      CloseHandle(file);
+      free(mapping);
+      return(NULL);
+      }
 
-   return(image);
-   }
+   size=st.QuadPart;
 
-// write a compressed PVM volume
-void writePVMvolume(const char *filename,unsigned char *volume,
-                    unsigned int width,unsigned int height,unsigned int depth,unsigned int components,
-                    float scalex,float scaley,float scalez,
-                    unsigned char *description,
-                    unsigned char *courtesy,
-                    unsigned char *parameter,
-                    unsigned char *comment)
-   {
-   char str[DDS_MAXSTR];
+   if ((map=CreateFileMappingA(file,NULL,PAGE_WRITECOPY,0,0,NULL))==NULL)
+      {
+      CloseHandle(file);
+      free(mapping);
+      return(NULL);
+      }
 
-   unsigned char *data;
+   base=(unsigned char *)MapViewOfFile(map,FILE_MAP_COPY,0,0,0);
 
-   unsigned int len1=1,len2=1,len3=1,len4=1;
+   CloseHandle(map);
+   CloseHandle(file);
 
-   if (width<1 || height<1 || depth<1 || components<1) ERRORMSG();
+   if (base==NULL)
+      {
+      free(mapping);
+      return(NULL);
+      }
 
-   if (description==NULL && courtesy==NULL && parameter==NULL && comment==NULL)
-      if (scalex==1.0f && scaley==1.0f && scalez==1.0f)
-         snprintf(str,DDS_MAXSTR,"PVM\n%d %d %d\n%d\n",width,height,depth,components);
-      else
-         snprintf(str,DDS_MAXSTR,"PVM2\n%d %d %d\n%g %g %g\n%d\n",width,height,depth,scalex,scaley,scalez,components);
-   else
-      snprintf(str,DDS_MAXSTR,"PVM3\n%d %d %d\n%g %g %g\n%d\n",width,height,depth,scalex,scaley,scalez,components);
+#endif
 
-   if (description==NULL && courtesy==NULL && parameter==NULL && comment==NULL)
-      {
-      if ((data=(unsigned char *)malloc(strlen(str)+width*height*depth*components))==NULL) ERRORMSG();
+   mapping->base=base;
+   mapping->size=size;
 
-      memcpy(data,str,strlen(str));
-      memcpy(data+strlen(str),volume,width*height*depth*components);
+   // compressed volumes cannot be mapped
+   if (size>=strlen(DDS_ID))
+      if (DDS_version((char *)base)!=0)
+         {
+         unmapPVMvolume(mapping);
+         return(NULL);
+         }
 
-      writeDDSfile(filename,data,strlen(str)+width*height*depth*components,components,width);
-      }
-   else
+   if ((len=PVM_parseheader(base,(size<DDS_MAXHEADER)?size:DDS_MAXHEADER,
+                            &mapping->version,
+                            &mapping->width,&mapping->height,&mapping->depth,&mapping->components,
+                            &mapping->scalex,&mapping->scaley,&mapping->scalez))==0)
       {
-      if (description!=NULL) len1=strlen((char *)description)+1;
-      if (courtesy!=NULL) len2=strlen((char *)courtesy)+1;
-      if (parameter!=NULL) len3=strlen((char *)parameter)+1;
-      if (comment!=NULL) len4=strlen((char *)comment)+1;
-
-      if ((data=(unsigned char *)malloc(strlen(str)+width*height*depth*components+len1+len2+len3+len4))==NULL) ERRORMSG();
+      unmapPVMvolume(mapping);
+      return(NULL);
+      }
 
-      memcpy(data,str,strlen(str));
-      memcpy(data+strlen(str),volume,width*height*depth*components);
+   voxels=(unsigned long long)mapping->width*mapping->height*mapping->depth*mapping->components;
+   if (size-len<voxels) ERRORMSG();
 
-      if (description==NULL) *(data+strlen(str)+width*height*depth*components)='\0';
-      else memcpy(data+strlen(str)+width*height*depth*components,description,len1);
+   mapping->voxels=base+len;
 
-      if (courtesy==NULL) *(data+strlen(str)+width*height*depth*components+len1)='\0';
-      else memcpy(data+strlen(str)+width*height*depth*components+len1,courtesy,len2);
+#ifndef _WIN32
+   madvise(base,size,random?MADV_RANDOM:MADV_SEQUENTIAL);
+#endif
 
-      if (parameter==NULL) *(data+strlen(str)+width*height*depth*components+len1+len2)='\0';
-      else memcpy(data+strlen(str)+width*height*depth*components+len1+len2,parameter,len3);
+   return(mapping);
+   }
 
-      if (comment==NULL) *(data+strlen(str)+width*height*depth*components+len1+len2+len3)='\0';
-      else memcpy(data+strlen(str)+width*height*depth*components+len1+len2+len3,comment,len4);
+// unmap a PVM volume
+void unmapPVMvolume(PVMmapping *mapping)
+   {
+#ifndef _WIN32
+   munmap(mapping->base,mapping->size);
+#else
+   UnmapViewOfFile(mapping->base);
+#endif
 
-      writeDDSfile(filename,data,strlen(str)+width*height*depth*components+len1+len2+len3+len4,components,width);
-      }
+   free(mapping);
    }
 
 // read a compressed PVM volume
+// * the voxels are streamed into the returned volume,
+//   so only a single copy of the volume is held in memory
 unsigned char *readPVMvolume(const char *filename,
                              unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components,
                              float *scalex,float *scaley,float *scalez,
@@ -769,92 +2468,70 @@ unsigned char *readPVMvolume(const char *filename,
                              unsigned char **parameter,
                              unsigned char **comment)
    {
-   unsigned char *data,*ptr;
-   unsigned int bytes,numc;
+   PVMstream *stream;
 
-   int version=1;
+   int version;
 
-   unsigned char *volume;
+   unsigned char *volume,*ptr;
+   unsigned long long voxels,trailer;
 
-   float sx=1.0f,sy=1.0f,sz=1.0f;
+   unsigned long long len1=0,len2=0,len3=0,len4=0;
 
-   unsigned int len1=0,len2=0,len3=0,len4=0;
+   if ((stream=openPVMvolume(filename,width,height,depth,components,scalex,scaley,scalez))==NULL) return(NULL);
 
-   if ((data=readDDSfile(filename,&bytes))==NULL)
-      if ((data=readRAWfile(filename,&bytes))==NULL) return(NULL);
+   version=stream->pvmversion;
 
-   if (bytes<5) return(NULL);
+   voxels=(unsigned long long)stream->width*stream->height*stream->depth*stream->components;
+   trailer=stream->total-stream->pos-voxels;
 
-   if ((data=(unsigned char *)realloc(data,bytes+1))==NULL) ERRORMSG();
-   data[bytes]='\0';
+   if (version!=3 && trailer!=0) ERRORMSG();
 
-   if (strncmp((char *)data,"PVM\n",4)!=0)
-      {
-      if (strncmp((char *)data,"PVM2\n",5)==0) version=2;
-      else if (strncmp((char *)data,"PVM3\n",5)==0) version=3;
-      else return(NULL);
+   if ((volume=(unsigned char *)malloc(voxels+trailer))==NULL) ERRORMSG();
 
-      ptr=&data[5];
-      if (sscanf((char *)ptr,"%d %d %d\n%g %g %g\n",width,height,depth,&sx,&sy,&sz)!=6) ERRORMSG();
-      if (*width<1 || *height<1 || *depth<1 || sx<=0.0f || sy<=0.0f || sz<=0.0f) ERRORMSG();
-      ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
-      }
-   else
-      {
-      ptr=&data[4];
-      while (*ptr=='#')
-         while (*ptr++!='\n');
+   readPVMslices(stream,volume);
+   PVM_fetch(stream,volume+voxels,trailer);
 
-      if (sscanf((char *)ptr,"%d %d %d\n",width,height,depth)!=3) ERRORMSG();
-      if (*width<1 || *height<1 || *depth<1) ERRORMSG();
-      }
+   closePVMvolume(stream);
 
-   if (scalex!=NULL && scaley!=NULL && scalez!=NULL)
+   // the trailer holds four zero-terminated strings
+   if (trailer>0)
       {
-      *scalex=sx;
-      *scaley=sy;
-      *scalez=sz;
+      ptr=volume+voxels;
+
+      if (memchr(ptr,'\0',trailer)==NULL) ERRORMSG();
+      len1=(unsigned char *)memchr(ptr,'\0',trailer)-ptr+1;
+      if (memchr(ptr+len1,'\0',trailer-len1)==NULL) ERRORMSG();
+      len2=(unsigned char *)memchr(ptr+len1,'\0',trailer-len1)-(ptr+len1)+1;
+      if (memchr(ptr+len1+len2,'\0',trailer-len1-len2)==NULL) ERRORMSG();
+      len3=(unsigned char *)memchr(ptr+len1+len2,'\0',trailer-len1-len2)-(ptr+len1+len2)+1;
+      if (memchr(ptr+len1+len2+len3,'\0',trailer-len1-len2-len3)==NULL) ERRORMSG();
+      len4=(unsigned char *)memchr(ptr+len1+len2+len3,'\0',trailer-len1-len2-len3)-(ptr+len1+len2+len3)+1;
+
+      if (len1+len2+len3+len4!=trailer) ERRORMSG();
       }
-
-   ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
-   if (sscanf((char *)ptr,"%d\n",&numc)!=1) ERRORMSG();
-   if (numc<1) ERRORMSG();
-
-   if (components!=NULL) *components=numc;
-   else if (numc!=1) ERRORMSG();
-
-   ptr=(unsigned char *)strchr((char *)ptr,'\n')+1;
-   if (version==3) len1=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc))+1;
-   if (version==3) len2=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1))+1;
-   if (version==3) len3=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1+len2))+1;
-   if (version==3) len4=strlen((char *)(ptr+(*width)*(*height)*(*depth)*numc+len1+len2+len3))+1;
-   if ((volume=(unsigned char *)malloc((*width)*(*height)*(*depth)*numc+len1+len2+len3+len4))==NULL) ERRORMSG();
-   if (data+bytes!=ptr+(*width)*(*height)*(*depth)*numc+len1+len2+len3+len4) ERRORMSG();
-
-   memcpy(volume,ptr,(*width)*(*height)*(*depth)*numc+len1+len2+len3+len4);
-   free(data);
+   else if (version==3) ERRORMSG();
 
    if (description!=NULL)
       {
-      if (len1>1) *description=volume+(*width)*(*height)*(*depth)*numc;
+      if (len1>1) *description=volume+voxels;
       else *description=NULL;
       }
 
    if (courtesy!=NULL)
       {
-      if (len2>1) *courtesy=volume+(*width)*(*height)*(*depth)*numc+len1;
+      if (len2>1) *courtesy=volume+voxels+len1;
       else *courtesy=NULL;
       }
 
    if (parameter!=NULL)
       {
-      if (len3>1) *parameter=volume+(*width)*(*height)*(*depth)*numc+len1+len2;
+      if (len3>1) *parameter=volume+voxels+len1+len2;
       else *parameter=NULL;
       }
 
    if (comment!=NULL)
       {
-      if (len4>1) *comment=volume+(*width)*(*height)*(*depth)*numc+len1+len2+len3;
+      if (len4>1) *comment=volume+voxels+len1+len2+len3;
       else *comment=NULL;
       }
 
@@ -972,56 +2649,146 @@ void convrgb(unsigned char **data,long long bytes)
    if ((*data=(unsigned char *)realloc(*data,bytes/3))==NULL) ERRORMSG();
    }
 
-// helper to get a short value from a volume
-inline int getshort(unsigned short int *data,
-                    long long width,long long height,long long depth,
-                    long long i,long long j,long long k)
-   {return(data[i+(j+k*height)*width]);}
-
-// helper to get a gradient value from a volume
-inline double getgrad(unsigned short int *data,
-                      long long width,long long height,long long depth,
-                      long long i,long long j,long long k)
+// compute the square root of the gradient magnitude of each voxel of a row of a volume
+// * the rows ym/yp and zm/zp are the neighbours of the row in y and z direction,
+//   their differences are scaled by fy and fz (1/2 for central, 1 for one-sided and 0 for no differences)
+// * the interior voxels are handled without branches, so the compiler can vectorize the loop
+inline void DDS_gradrow(const unsigned short int *row,
+                        const unsigned short int *ym,const unsigned short int *yp,double fy,
+                        const unsigned short int *zm,const unsigned short int *zp,double fz,
+                        long long width,
+                        double *grad)
    {
+   long long i;
+
    double gx,gy,gz;
 
-   if (i>0)
-      if (i<width-1) gx=(getshort(data,width,height,depth,i+1,j,k)-getshort(data,width,height,depth,i-1,j,k))/2.0;
-      else gx=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i-1,j,k);
-   else
-      if (i<width-1) gx=getshort(data,width,height,depth,i+1,j,k)-getshort(data,width,height,depth,i,j,k);
+   for (i=1; i<width-1; i++)
+      {
+      gx=(row[i+1]-row[i-1])*0.5;
+      gy=(yp[i]-ym[i])*fy;
+      gz=(zp[i]-zm[i])*fz;
+
+      grad[i]=gx*gx+gy*gy+gz*gz;
+      }
+
+#ifdef __SSE2__
+   for (i=1; i+1<width-1; i+=2)
+      _mm_storeu_pd(&grad[i],_mm_sqrt_pd(_mm_sqrt_pd(_mm_loadu_pd(&grad[i]))));
+   for (; i<width-1; i++) grad[i]=sqrt(sqrt(grad[i]));
+#else
+   for (i=1; i<width-1; i++) grad[i]=sqrt(sqrt(grad[i]));
+#endif
+
+   for (i=0; i<width; i+=(width>1)?width-1:1)
+      {
+      if (i>0) gx=row[i]-row[i-1];
+      else if (i<width-1) gx=row[i+1]-row[i];
       else gx=0.0;
 
-   if (j>0)
-      if (j<height-1) gy=(getshort(data,width,height,depth,i,j+1,k)-getshort(data,width,height,depth,i,j-1,k))/2.0;
-      else gy=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i,j-1,k);
-   else
-      if (j<height-1) gy=getshort(data,width,height,depth,i,j+1,k)-getshort(data,width,height,depth,i,j,k);
-      else gy=0.0;
+      gy=(yp[i]-ym[i])*fy;
+      gz=(zp[i]-zm[i])*fz;
 
-   if (k>0)
-      if (k<depth-1) gz=(getshort(data,width,height,depth,i,j,k+1)-getshort(data,width,height,depth,i,j,k-1))/2.0;
-      else gz=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i,j,k-1);
-   else
-      if (k<depth-1) gz=getshort(data,width,height,depth,i,j,k+1)-getshort(data,width,height,depth,i,j,k);
-      else gz=0.0;
+      grad[i]=sqrt(sqrt(gx*gx+gy*gy+gz*gz));
+      }
+   }
+
+// accumulate the gradient magnitude histogram of a volume
+// * the histogram entry of each voxel value is increased by the square root of the gradient magnitude
+// * the gradients of a batch of rows are computed on all threads,
+//   while one thread adds the gradients of the previous batch to the histogram
+// * the gradients are added in voxel order, so each histogram entry is summed in the same order
+//   as by a serial pass and the histogram does not depend on the number of threads
+void DDS_gradhist(const unsigned short int *data,
+                  long long width,long long height,long long depth,
+                  double *err,
+                  unsigned int threads)
+   {
+   long long i;
+
+   long long rows,batch,r0;
+   unsigned int cur,prev;
+
+   double *grad[2];
+
+   rows=height*depth;
+
+   batch=(1<<20)/width;
+   if (batch<1) batch=1;
+   if (batch>rows) batch=rows;
+
+   if ((grad[0]=(double *)malloc(batch*width*sizeof(double)))==NULL) ERRORMSG();
+   if ((grad[1]=(double *)malloc(batch*width*sizeof(double)))==NULL) ERRORMSG();
+
+   for (i=0; i<65536; i++) err[i]=0.0;
+
+   for (r0=0; r0<rows+batch; r0+=batch)
+      {
+      cur=(r0<rows)?((rows-r0<batch)?rows-r0:batch):0;
+      prev=(r0>0)?((rows-r0+batch<batch)?rows-r0+batch:batch):0;
+
+      DDS_parallel(cur+1,[&](unsigned int n)
+         {
+         long long i,j,k,r;
+
+         const unsigned short int *row,*ym,*yp,*zm,*zp;
+         double fy,fz,*g;
+
+         // the first job adds the previous batch
+         if (n==0)
+            {
+            g=grad[(r0/batch+1)%2];
+
+            for (r=r0-batch; r<r0-batch+prev; r++,g+=width)
+               {
+               row=data+r*width;
+               for (i=0; i<width; i++) err[row[i]]+=g[i];
+               }
+
+            return;
+            }
+
+         r=r0+n-1;
+
+         j=r%height;
+         k=r/height;
+
+         row=data+r*width;
+
+         ym=(j>0)?row-width:row;
+         yp=(j<height-1)?row+width:row;
+         fy=(j>0 && j<height-1)?0.5:(height>1)?1.0:0.0;
+
+         zm=(k>0)?row-width*height:row;
+         zp=(k<depth-1)?row+width*height:row;
+         fz=(k>0 && k<depth-1)?0.5:(depth>1)?1.0:0.0;
+
+         DDS_gradrow(row,ym,yp,fy,zm,zp,fz,width,grad[(r0/batch)%2]+(n-1)*width);
+         },threads);
+      }
 
-   return(sqrt(gx*gx+gy*gy+gz*gz));
+   free(grad[0]);
+   free(grad[1]);
    }
 
 // quantize 16 bit data to 8 bit using a non-linear mapping
+// * the volume is processed on all available cores or on the given number of threads
+// * the mapping does not depend on the number of threads
 unsigned char *quantize(unsigned char *data,
                         long long width,long long height,long long depth,
                         BOOLINT msb,
-                        BOOLINT linear,BOOLINT nofree)
+                        BOOLINT linear,BOOLINT nofree,
+                        unsigned int threads)
    {
-   long long i,j,k;
+   long long i,k;
+
+   unsigned int t,slabs;
 
    unsigned char *data2;
    unsigned short int *data3;
-   long long idx;
 
-   int v,vmin,vmax;
+   int vmin,vmax;
+   int *tmin,*tmax;
 
    double *err,eint;
 
@@ -1029,24 +2796,50 @@ unsigned char *quantize(unsigned char *data,
 
    if ((data3=(unsigned short int*)malloc(width*height*depth*sizeof(unsigned short int)))==NULL) ERRORMSG();
 
+   if (threads==0) threads=DDS_threads();
+
+   // the min/max and the mapping pass work on slabs of slices
+   slabs=threads;
+   if (slabs>depth) slabs=depth;
+
+   if ((tmin=(int *)malloc(slabs*sizeof(int)))==NULL) ERRORMSG();
+   if ((tmax=(int *)malloc(slabs*sizeof(int)))==NULL) ERRORMSG();
+
+   DDS_parallel(slabs,[&](unsigned int n)
+      {
+      long long idx,idx0,idx1;
+      int v;
+
+      idx0=depth*n/slabs*width*height;
+      idx1=depth*(n+1)/slabs*width*height;
+
+      tmin[n]=65535;
+      tmax[n]=0;
+
+      for (idx=idx0; idx<idx1; idx++)
+         {
+         if (msb)
+            v=256*data[2*idx]+data[2*idx+1];
+         else
+            v=data[2*idx]+256*data[2*idx+1];
+         data3[idx]=v;
+
+         if (v<tmin[n]) tmin[n]=v;
+         if (v>tmax[n]) tmax[n]=v;
+         }
+      },threads);
+
    vmin=65535;
    vmax=0;
 
-   for (k=0; k<depth; k++)
-      for (j=0; j<height; j++)
-         for (i=0; i<width; i++)
-            {
-            idx=i+(j+k*height)*width;
-
-            if (msb)
-               v=256*data[2*idx]+data[2*idx+1];
-            else
-               v=data[2*idx]+256*data[2*idx+1];
-            data3[idx]=v;
+   for (t=0; t<slabs; t++)
+      {
+      if (tmin[t]<vmin) vmin=tmin[t];
+      if (tmax[t]>vmax) vmax=tmax[t];
+      }
 
-            if (v<vmin) vmin=v;
-            if (v>vmax) vmax=v;
-            }
+   free(tmin);
+   free(tmax);
 
    if (!nofree) free(data);
 
@@ -1060,12 +2853,7 @@ unsigned char *quantize(unsigned char *data,
       for (i=0; i<65536; i++) err[i]=255*(double)(i-vmin)/(vmax-vmin);
    else
       {
-      for (i=0; i<65536; i++) err[i]=0.0;
-
-      for (k=0; k<depth; k++)
-         for (j=0; j<height; j++)
-            for (i=0; i<width; i++)
-               err[getshort(data3,width,height,depth,i,j,k)]+=sqrt(getgrad(data3,width,height,depth,i,j,k));
+      DDS_gradhist(data3,width,height,depth,err,threads);
 
       for (i=0; i<65536; i++) err[i]=pow(err[i],1.0/3);
 
@@ -1095,15 +2883,18 @@ unsigned char *quantize(unsigned char *data,
 
    if ((data2=(unsigned char *)malloc(width*height*depth))==NULL) ERRORMSG();
 
-   for (k=0; k<depth; k++)
-      for (j=0; j<height; j++)
-         for (i=0; i<width; i++)
-            {
-            idx=i+(j+k*height)*width;
-            data2[idx]=(int)(err[data3[idx]]+0.5);
-            }
+   DDS_parallel(slabs,[&](unsigned int n)
+      {
+      long long idx,idx0,idx1;
+
+      idx0=depth*n/slabs*width*height;
+      idx1=depth*(n+1)/slabs*width*height;
+
+      for (idx=idx0; idx<idx1; idx++)
+         data2[idx]=(int)(err[data3[idx]]+0.5);
+      },threads);
 
-   delete err;
+   delete[] err;
    free(data3);
 
    return(data2);
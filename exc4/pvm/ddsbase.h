@@ -5,10 +5,28 @@
 
 #include "defs.h"
 
-void writeDDSfile(const char *filename,unsigned char *data,unsigned int bytes,unsigned int skip=0,unsigned int strip=0,BOOLINT nofree=FALSE);
+// codecs of DDS files
+// * the classic DDS coder is a run-length coder of the bit widths of delta predicted values
+// * the other codecs are byte coders applied to the delta filtered stream
+#define DDS_CODEC_DDS (0)
+#define DDS_CODEC_LZ4 (1)
+
+#define DDS_CODECS (16)
+
+typedef void (*DDS_encoder)(const unsigned char *data,unsigned int bytes,unsigned char **chunk,unsigned int *size);
+typedef BOOLINT (*DDS_decoder)(const unsigned char *chunk,unsigned int size,unsigned char *data,unsigned int bytes);
+
+void registerDDScodec(unsigned int codec,DDS_encoder encode,DDS_decoder decode);
+
+void writeDDSfile(const char *filename,unsigned char *data,long long bytes,unsigned int skip=0,unsigned int strip=0,BOOLINT nofree=FALSE,
+                  unsigned int codec=DDS_CODEC_DDS);
+unsigned char *readDDSfile(const char *filename,long long *bytes);
 unsigned char *readDDSfile(const char *filename,unsigned int *bytes);
 
-void writeRAWfile(const char *filename,unsigned char *data,unsigned int bytes,BOOLINT nofree=FALSE);
+BOOLINT extractDDSfile(const char *filename,const char *output,long long *bytes=NULL);
+
+void writeRAWfile(const char *filename,unsigned char *data,long long bytes,BOOLINT nofree=FALSE);
+unsigned char *readRAWfile(const char *filename,long long *bytes);
 unsigned char *readRAWfile(const char *filename,unsigned int *bytes);
 
 void writePNMimage(const char *filename,unsigned char *image,unsigned int width,unsigned int height,unsigned int components,BOOLINT dds=FALSE);
@@ -20,7 +38,18 @@ void writePVMvolume(const char *filename,unsigned char *volume,
                     unsigned char *description=NULL,
                     unsigned char *courtesy=NULL,
                     unsigned char *parameter=NULL,
-                    unsigned char *comment=NULL);
+                    unsigned char *comment=NULL,
+                    unsigned int codec=DDS_CODEC_DDS);
+
+void writePVMslices(const char *filename,
+                    void (*slice)(unsigned char *data,unsigned int z,void *user),void *user,
+                    unsigned int width,unsigned int height,unsigned int depth,unsigned int components=1,
+                    float scalex=1.0f,float scaley=1.0f,float scalez=1.0f,
+                    unsigned char *description=NULL,
+                    unsigned char *courtesy=NULL,
+                    unsigned char *parameter=NULL,
+                    unsigned char *comment=NULL,
+                    unsigned int codec=DDS_CODEC_DDS);
 
 unsigned char *readPVMvolume(const char *filename,
                              unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components=NULL,
@@ -30,6 +59,32 @@ unsigned char *readPVMvolume(const char *filename,
                              unsigned char **parameter=NULL,
                              unsigned char **comment=NULL);
 
+struct PVMstream;
+
+PVMstream *openPVMvolume(const char *filename,
+                         unsigned int *width,unsigned int *height,unsigned int *depth,unsigned int *components=NULL,
+                         float *scalex=NULL,float *scaley=NULL,float *scalez=NULL);
+
+void readPVMslices(PVMstream *stream,unsigned char *volume,
+                   void (*slice)(unsigned char *data,unsigned int z,void *user)=NULL,void *user=NULL);
+
+void closePVMvolume(PVMstream *stream);
+
+struct PVMmapping
+   {
+   unsigned char *voxels; // voxels in the page cache
+
+   int version;
+   unsigned int width,height,depth,components;
+   float scalex,scaley,scalez;
+
+   void *base; // mapped file
+   unsigned long long size;
+   };
+
+PVMmapping *mapPVMvolume(const char *filename,BOOLINT random=FALSE);
+void unmapPVMvolume(PVMmapping *mapping);
+
 int checkfile(const char *filename);
 unsigned int checksum(unsigned char *data,unsigned int bytes);
 
@@ -41,6 +96,7 @@ void convrgb(unsigned char **data,long long bytes);
 unsigned char *quantize(unsigned char *volume,
                         long long width,long long height,long long depth,
                         BOOLINT msb=FALSE,
-                        BOOLINT linear=FALSE,BOOLINT nofree=FALSE);
+                        BOOLINT linear=FALSE,BOOLINT nofree=FALSE,
+                        unsigned int threads=0);
 
 #endif
@@ -0,0 +1,326 @@
+// (c) by Stefan Roettger, licensed under MIT license
+
+// regression test of the DDS codec against streams of the former coder
+// * the encoded streams of several data kinds, skips and strips must match the reference streams,
+//   and the reference streams must decode to their source
+// * legacy v3d and v3e files must decode to their source
+// * decoding into an output buffer or file must match the decoding on the heap
+// * the codec source is included to reach its internals
+
+#include "ddsbase.cpp"
+
+#include "test_dds_fixtures.h"
+
+// fill a stream with one of the data kinds of the reference streams
+// * 0: constant, 1: ramp, 2: smooth signal plus noise, 3: random bytes, 4: smooth signal with spikes
+void fill(unsigned char *data,unsigned int bytes,unsigned int kind,unsigned int seed)
+   {
+   unsigned int i;
+
+   for (i=0; i<bytes; i++)
+      {
+      seed=seed*1103515245+12345;
+
+      if (kind==0) data[i]=77;
+      else if (kind==1) data[i]=i*3;
+      else if (kind==2) data[i]=i/5+((seed>>16)&3);
+      else if (kind==3) data[i]=seed>>16;
+      else data[i]=((seed>>16)%61==0)?seed>>8:i/7+((seed>>16)&1);
+      }
+   }
+
+// write a buffer into a file
+void writefile(const char *filename,const unsigned char *data,unsigned int bytes)
+   {
+   writeRAWfile(filename,(unsigned char *)data,bytes,TRUE);
+   }
+
+// compare a RAW file with a buffer
+BOOLINT samefile(const char *filename,const unsigned char *data,long long bytes)
+   {
+   unsigned char *file;
+   long long size;
+
+   BOOLINT ok;
+
+   if ((file=readRAWfile(filename,&size))==NULL) return(FALSE);
+
+   ok=(size==bytes && memcmp(file,data,bytes)==0);
+
+   free(file);
+
+   return(ok);
+   }
+
+// check the encoder and the decoder against a reference stream
+BOOLINT check_fixture(const DDS_fixture *f)
+   {
+   unsigned char *data,*chunk,*out,*output;
+   unsigned int size,cnt;
+
+   BOOLINT ok;
+
+   if ((data=(unsigned char *)malloc(f->bytes))==NULL) ERRORMSG();
+   if ((output=(unsigned char *)malloc(f->bytes))==NULL) ERRORMSG();
+
+   fill(data,f->bytes,f->kind,f->kind+7*f->skip+31*f->strip+f->bytes);
+
+   DDS_encode(data,f->bytes,f->skip,f->strip,&chunk,&size);
+
+   ok=(size==f->size && checksum(chunk,size)==f->sum);
+   if (f->stream!=NULL) ok=ok && memcmp(chunk,f->stream,size)==0;
+
+   if (!ok) fprintf(stderr,"stream of kind %u with %u bytes, skip %u and strip %u differs from the reference\n",f->kind,f->bytes,f->skip,f->strip);
+
+   // the reference stream is decoded, where it is stored
+   if (f->stream!=NULL)
+      {
+      free(chunk);
+
+      if ((chunk=(unsigned char *)malloc(f->size))==NULL) ERRORMSG();
+      memcpy(chunk,f->stream,f->size);
+      size=f->size;
+      }
+
+   DDS_decode(chunk,size,&out,&cnt);
+
+   if (cnt!=f->bytes || memcmp(out,data,f->bytes)!=0)
+      {
+      fprintf(stderr,"decode of kind %u with %u bytes, skip %u and strip %u differs from the source\n",f->kind,f->bytes,f->skip,f->strip);
+      ok=FALSE;
+      }
+
+   free(out);
+
+   DDS_decode(chunk,size,&out,&cnt,0,f->bytes,output);
+
+   if (out!=output || cnt!=f->bytes || memcmp(output,data,f->bytes)!=0)
+      {
+      fprintf(stderr,"decode of kind %u with %u bytes, skip %u and strip %u into the output differs from the source\n",f->kind,f->bytes,f->skip,f->strip);
+      ok=FALSE;
+      }
+
+   free(data);
+   free(chunk);
+   free(output);
+
+   return(ok);
+   }
+
+// check the decoding of a legacy DDS file
+BOOLINT check_legacy(const char *filename,const unsigned char *data,unsigned int bytes)
+   {
+   unsigned char *out;
+   long long cnt,size;
+
+   BOOLINT ok;
+
+   ok=TRUE;
+
+   if ((out=readDDSfile(filename,&cnt))==NULL || cnt!=bytes || memcmp(out,data,bytes)!=0)
+      {
+      fprintf(stderr,"read of legacy file %s differs from the source\n",filename);
+      ok=FALSE;
+      }
+
+   free(out);
+
+   if (!extractDDSfile(filename,"test_dds_codec.raw",&size) || size!=bytes ||
+       !samefile("test_dds_codec.raw",data,bytes))
+      {
+      fprintf(stderr,"extraction of legacy file %s differs from the source\n",filename);
+      ok=FALSE;
+      }
+
+   remove("test_dds_codec.raw");
+
+   return(ok);
+   }
+
+// check the legacy v3d files
+BOOLINT check_v3d()
+   {
+   unsigned char data[1000];
+   unsigned char volume[9*7*5*2];
+
+   unsigned char *out,*description;
+   unsigned int width,height,depth,components;
+   float scalex,scaley,scalez;
+
+   BOOLINT ok;
+
+   fill(data,1000,2,7);
+
+   writefile("test_dds_codec_v3d.dds",legacy_v3d_dds,sizeof(legacy_v3d_dds));
+   ok=check_legacy("test_dds_codec_v3d.dds",data,1000);
+   remove("test_dds_codec_v3d.dds");
+
+   fill(volume,9*7*5*2,4,11);
+
+   writefile("test_dds_codec_v3d.pvm",legacy_v3d_pvm,sizeof(legacy_v3d_pvm));
+
+   out=readPVMvolume("test_dds_codec_v3d.pvm",&width,&height,&depth,&components,&scalex,&scaley,&scalez,&description);
+
+   if (out==NULL ||
+       width!=9 || height!=7 || depth!=5 || components!=2 ||
+       scalex!=1.0f || scaley!=2.0f || scalez!=0.5f ||
+       description==NULL || strcmp((char *)description,"legacy volume")!=0 ||
+       memcmp(out,volume,9*7*5*2)!=0)
+      {
+      fprintf(stderr,"read of legacy volume differs from the source\n");
+      ok=FALSE;
+      }
+
+   free(out);
+
+   remove("test_dds_codec_v3d.pvm");
+
+   return(ok);
+   }
+
+// check the legacy v3e file
+// * the file is written in the legacy layout,
+//   its checksum proves that it is identical to the file of the former coder
+BOOLINT check_v3e()
+   {
+   unsigned char *data,*chunk,*file;
+   unsigned int size;
+
+   BOOLINT ok;
+
+   if ((data=(unsigned char *)malloc(LEGACY_V3E_BYTES))==NULL) ERRORMSG();
+
+   fill(data,LEGACY_V3E_BYTES,2,13);
+
+   DDS_encode(data,LEGACY_V3E_BYTES,2,3,&chunk,&size,DDS_INTERLEAVE);
+
+   if ((file=(unsigned char *)malloc(strlen(DDS_ID2)+size))==NULL) ERRORMSG();
+
+   memcpy(file,DDS_ID2,strlen(DDS_ID2));
+   memcpy(file+strlen(DDS_ID2),chunk,size);
+
+   size+=strlen(DDS_ID2);
+
+   ok=(size==LEGACY_V3E_SIZE && checksum(file,size)==LEGACY_V3E_SUM);
+
+   if (!ok) fprintf(stderr,"legacy v3e file differs from the reference\n");
+
+   writefile("test_dds_codec_v3e.dds",file,size);
+   ok=check_legacy("test_dds_codec_v3e.dds",data,LEGACY_V3E_BYTES) && ok;
+   remove("test_dds_codec_v3e.dds");
+
+   free(data);
+   free(chunk);
+   free(file);
+
+   return(ok);
+   }
+
+// check the decoding of a chunked file into the output against the decoding on the heap
+BOOLINT check_output(unsigned int codec)
+   {
+   const unsigned int bytes=3*DDS_CHUNKSIZE+12345;
+
+   unsigned char *data,*out,*output,**piece;
+   long long cnt,size;
+
+   FILE *file;
+   char id[sizeof(DDS_ID)];
+   long pos;
+
+   unsigned int chunks,*raw,*coded,c;
+   unsigned long long total,offset;
+
+   BOOLINT ok;
+
+   if ((data=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   fill(data,bytes,4,codec);
+
+   writeDDSfile("test_dds_codec.dds",data,bytes,2,100,TRUE,codec);
+
+   ok=TRUE;
+
+   if ((out=readDDSfile("test_dds_codec.dds",&cnt))==NULL || cnt!=bytes || memcmp(out,data,bytes)!=0)
+      {
+      fprintf(stderr,"read of chunked file with codec %u differs from the source\n",codec);
+      ok=FALSE;
+      }
+
+   if (!extractDDSfile("test_dds_codec.dds","test_dds_codec.raw",&size) || size!=bytes ||
+       out==NULL || !samefile("test_dds_codec.raw",out,bytes))
+      {
+      fprintf(stderr,"extraction of chunked file with codec %u differs from the read\n",codec);
+      ok=FALSE;
+      }
+
+   remove("test_dds_codec.raw");
+
+   // all chunks are read at once into pieces and into the output
+   if ((file=fopen("test_dds_codec.dds","rb"))==NULL) ERRORMSG();
+   if (fread(id,strlen(DDS_ID),1,file)!=1) ERRORMSG();
+
+   if (!DDS_readtable(file,DDS_version(id),&codec,&chunks,&raw,&coded,&total)) ERRORMSG();
+   if (total!=bytes || chunks<4) ERRORMSG();
+
+   pos=ftell(file);
+
+   if ((piece=(unsigned char **)malloc(chunks*sizeof(unsigned char *)))==NULL) ERRORMSG();
+   if ((output=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   DDS_readbatch(file,codec,chunks,raw,coded,piece);
+
+   for (offset=0,c=0; c<chunks; offset+=raw[c],c++)
+      {
+      if (out==NULL || memcmp(piece[c],out+offset,raw[c])!=0)
+         {
+         fprintf(stderr,"batch read of chunk %u with codec %u differs from the read\n",c,codec);
+         ok=FALSE;
+         }
+
+      free(piece[c]);
+      }
+
+   fseek(file,pos,SEEK_SET);
+
+   DDS_readbatch(file,codec,chunks,raw,coded,NULL,output);
+
+   if (out==NULL || memcmp(output,out,bytes)!=0)
+      {
+      fprintf(stderr,"batch read into the output with codec %u differs from the read\n",codec);
+      ok=FALSE;
+      }
+
+   fclose(file);
+
+   remove("test_dds_codec.dds");
+
+   free(data);
+   free(out);
+   free(output);
+   free(piece);
+   free(raw);
+   free(coded);
+
+   return(ok);
+   }
+
+int main(int argc,char *argv[])
+   {
+   unsigned int i;
+
+   BOOLINT ok=TRUE;
+
+   for (i=0; i<sizeof(fixtures)/sizeof(fixtures[0]); i++)
+      if (!check_fixture(&fixtures[i])) ok=FALSE;
+
+   if (!check_v3d()) ok=FALSE;
+   if (!check_v3e()) ok=FALSE;
+
+   if (!check_output(DDS_CODEC_DDS)) ok=FALSE;
+   if (!check_output(DDS_CODEC_LZ4)) ok=FALSE;
+
+   printf("%s\n",ok?"passed":"FAILED");
+
+   return(ok?0:1);
+   }
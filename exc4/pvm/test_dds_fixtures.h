@@ -0,0 +1,835 @@
+// (c) by Stefan Roettger, licensed under MIT license
+
+// reference streams of the DDS coder
+// * written by the coder that preceded the single-pass encoder and the 64-bit bit reader
+// * the source streams are generated by fill() of test_dds_codec.cpp,
+//   the streams of the table are seeded with kind+7*skip+31*strip+bytes
+// * the short streams are stored byte by byte, the long ones by their size and checksum
+
+#ifndef TEST_DDS_FIXTURES_H
+#define TEST_DDS_FIXTURES_H
+
+struct DDS_fixture
+   {
+   unsigned int kind,skip,strip; // source stream
+   unsigned int bytes;
+
+   unsigned int size,sum; // size and checksum of the reference stream
+   const unsigned char *stream; // reference stream or NULL
+   };
+
+static const unsigned char fixture_0_1_1[7]=
+   {
+   0x00,0x00,0x00,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_1_3[7]=
+   {
+   0x00,0x00,0x80,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_1_16[7]=
+   {
+   0x00,0x03,0xc0,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_2_1[7]=
+   {
+   0x40,0x00,0x00,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_2_3[7]=
+   {
+   0x40,0x00,0x80,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_2_16[7]=
+   {
+   0x40,0x03,0xc0,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_3_1[7]=
+   {
+   0x80,0x00,0x00,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_3_3[7]=
+   {
+   0x80,0x00,0x80,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_3_16[7]=
+   {
+   0x80,0x03,0xc0,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_4_1[7]=
+   {
+   0xc0,0x00,0x00,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_4_3[7]=
+   {
+   0xc0,0x00,0x80,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_0_4_16[7]=
+   {
+   0xc0,0x03,0xc0,0xfc,0xdf,0xe2,0x40
+   };
+
+static const unsigned char fixture_1_1_1[81]=
+   {
+   0x00,0x00,0x00,0x8f,0xeb,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+   0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+   0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+   0xff,0xff,0xff,0xff,0xf2,0x17,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+   0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+   0xf8
+   };
+
+static const unsigned char fixture_1_1_3[8]=
+   {
+   0x00,0x00,0x82,0x29,0xff,0xfe,0x22,0x80
+   };
+
+static const unsigned char fixture_1_1_16[13]=
+   {
+   0x00,0x03,0xc8,0xa9,0xff,0xff,0xff,0xff,0xff,0xff,0xfc,0x38,0x00
+   };
+
+static const unsigned char fixture_1_2_1[107]=
+   {
+   0x40,0x00,0x32,0x38,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xe0,0x3c,0xc7,0x1b,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,
+   0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xe0
+   };
+
+static const unsigned char fixture_1_2_3[14]=
+   {
+   0x40,0x00,0x82,0x38,0xee,0xec,0x00,0x0f,0x2b,0x04,0x00,0xfd,0x5c,0x00
+   };
+
+static const unsigned char fixture_1_2_16[21]=
+   {
+   0x40,0x03,0xc8,0xb8,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xee,0xa6,0x00,0xf2,0xb1,
+   0xe0,0x0f,0xd5,0xa6,0x00
+   };
+
+static const unsigned char fixture_1_3_1[135]=
+   {
+   0x80,0x00,0x21,0xc8,0x67,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,
+   0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,
+   0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x20,0x79,0x8c,
+   0x29,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,
+   0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,
+   0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0x81,0xe6,0x30,0x66,0x73,0x9c,
+   0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,
+   0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,
+   0xce,0x73,0x9c,0xe7,0x39,0xce,0x40
+   };
+
+static const unsigned char fixture_1_3_3[22]=
+   {
+   0x80,0x00,0x82,0x48,0x67,0x39,0x7e,0x00,0xf2,0x80,0x40,0x0f,0xd8,0x7e,0x00,0xf2,
+   0x80,0x40,0x0f,0xd8,0x7c,0x00
+   };
+
+static const unsigned char fixture_1_3_16[30]=
+   {
+   0x80,0x03,0xc8,0xc8,0x67,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xb2,0x00,
+   0x79,0x40,0xf0,0x07,0xec,0x32,0x00,0x79,0x40,0xf0,0x07,0xec,0x31,0x00
+   };
+
+static const unsigned char fixture_1_4_1[138]=
+   {
+   0xc0,0x00,0x19,0x48,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,
+   0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,
+   0x39,0xce,0x70,0x0f,0x37,0x63,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,
+   0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,
+   0xce,0x73,0x9c,0xe7,0x38,0x07,0x9b,0xb1,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,
+   0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,
+   0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0x03,0xcd,0xd8,0xce,0x73,0x9c,0xe7,0x39,0xce,
+   0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x73,
+   0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x00
+   };
+
+static const unsigned char fixture_1_4_3[29]=
+   {
+   0xc0,0x00,0x82,0x48,0x73,0x9c,0x5c,0x00,0xf2,0xb0,0x40,0x0f,0xd5,0x5c,0x00,0xf2,
+   0xb0,0x40,0x0f,0xd5,0x5c,0x00,0xf2,0xb0,0x40,0x0f,0xd5,0x5c,0x00
+   };
+
+static const unsigned char fixture_1_4_16[37]=
+   {
+   0xc0,0x03,0xc8,0xc8,0x73,0x9c,0xe7,0x39,0xce,0x73,0x9c,0xe7,0x39,0xce,0x21,0x00,
+   0x79,0x58,0xf0,0x07,0xea,0xa1,0x00,0x79,0x58,0xf0,0x07,0xea,0xa1,0x00,0x79,0x58,
+   0xf0,0x07,0xea,0xa1,0x00
+   };
+
+static const unsigned char fixture_2_1_1[93]=
+   {
+   0x00,0x00,0x32,0x2a,0xeb,0xd3,0x35,0xea,0xc6,0x67,0xe1,0xbd,0x4b,0x63,0xaa,0xe9,
+   0x5e,0x75,0x5c,0xa3,0xbd,0x55,0xdb,0xeb,0x4a,0xec,0x92,0x99,0x73,0xce,0xb8,0xfd,
+   0x55,0xd9,0x5c,0xd6,0x43,0xd4,0x9d,0xbf,0x0c,0xc8,0xf2,0x21,0xe1,0xe9,0xea,0x1d,
+   0xee,0x21,0xaa,0x56,0x6e,0x1d,0xe2,0xda,0x61,0xaa,0x29,0x6a,0x9a,0x9a,0xa5,0x62,
+   0x6a,0x56,0x61,0xf1,0x66,0x9a,0xa2,0x25,0x72,0x16,0xe2,0x61,0x9e,0xde,0x21,0xed,
+   0xe9,0x62,0xde,0xa2,0x1d,0xee,0x1d,0xa6,0x25,0xea,0x96,0xd6,0x00
+   };
+
+static const unsigned char fixture_2_1_3[104]=
+   {
+   0x00,0x00,0x97,0x38,0xa6,0xb4,0xc4,0xc3,0xa9,0xb7,0x55,0xa9,0xc5,0x58,0xca,0x72,
+   0x98,0xb7,0x99,0xa4,0x76,0xc9,0x96,0x95,0xc4,0xa4,0xc2,0xea,0xd4,0xac,0xe3,0x1e,
+   0xad,0xb5,0x3b,0x8c,0x54,0x5e,0x35,0xad,0x1f,0x25,0xa5,0xc4,0x35,0xc4,0x24,0xc6,
+   0x34,0xa5,0xbd,0x2c,0xbd,0x45,0x44,0x32,0xd4,0xc4,0x34,0xc4,0xd3,0x3c,0xb5,0xa6,
+   0xa4,0xc4,0xda,0xcb,0x35,0x4b,0xb4,0x5c,0x4c,0xba,0xcc,0x52,0xdb,0xc3,0x94,0x52,
+   0x4b,0xa2,0x86,0x5b,0x55,0xed,0xb6,0x2d,0xea,0xc2,0x65,0xab,0x3e,0xb0,0xe5,0x24,
+   0xa3,0x9d,0x66,0x1c,0x05,0x7a,0xee,0x92
+   };
+
+static const unsigned char fixture_2_1_16[101]=
+   {
+   0x00,0x03,0xd2,0x2d,0x4d,0xb3,0x2b,0x1c,0x9d,0x6a,0x74,0xad,0xd7,0x9c,0xa7,0xa9,
+   0xad,0x16,0xce,0x6a,0x25,0x2a,0x62,0x60,0x29,0x47,0x49,0xbd,0x85,0x78,0xb8,0x86,
+   0x87,0x9a,0x97,0x84,0xa8,0x32,0xab,0xae,0xc8,0xa6,0x87,0x53,0x9c,0xb4,0xe3,0xbe,
+   0x86,0x75,0x87,0x52,0xb5,0x4b,0x11,0x31,0x2b,0x70,0xf6,0xb1,0x2f,0x0f,0x72,0x9a,
+   0xce,0xf1,0x2b,0x54,0xb4,0xf4,0xb1,0x2b,0x34,0xf2,0xf3,0x4b,0x70,0xb4,0xd4,0xf1,
+   0x51,0x45,0x72,0xcf,0x6b,0x69,0x53,0x4a,0xf1,0x18,0x71,0x16,0xb4,0xf3,0x47,0x3a,
+   0xd2,0x93,0x72,0xcf,0x14
+   };
+
+static const unsigned char fixture_2_2_1[99]=
+   {
+   0x40,0x00,0x09,0x2b,0x32,0xf5,0xd5,0x67,0x8d,0xf8,0xa4,0xbc,0x7a,0x59,0xb7,0x7b,
+   0x89,0x68,0x8b,0x89,0x88,0x79,0x79,0xb6,0xa8,0x97,0x8b,0x87,0x89,0x79,0x89,0x89,
+   0x98,0x8a,0x98,0x97,0x78,0x8b,0x79,0x96,0xaa,0x5b,0x7b,0x86,0x8b,0x77,0xa9,0x89,
+   0x08,0x02,0xaf,0x1e,0x41,0x71,0xb7,0xd0,0xde,0xc1,0x90,0xa4,0xd3,0x45,0xe3,0xb2,
+   0xb9,0x65,0xf2,0xb9,0x9b,0xd1,0xdd,0x2d,0x7a,0x4a,0xba,0xaf,0xd8,0xe4,0xb3,0x2b,
+   0xa5,0xa7,0x4f,0x1d,0x79,0xd7,0x02,0x3c,0x69,0x91,0x2a,0x49,0x5e,0x8f,0x84,0x01,
+   0x96,0x93,0x36
+   };
+
+static const unsigned char fixture_2_2_3[106]=
+   {
+   0x40,0x00,0x8c,0xa9,0x35,0x91,0x48,0xac,0xd8,0xc5,0xb3,0x74,0xd7,0x2d,0xe4,0xb3,
+   0x45,0xbb,0xad,0xc5,0x3b,0xcb,0x5a,0x6a,0x61,0xc3,0xec,0x3b,0xbd,0xa5,0x35,0x5c,
+   0x2b,0xbd,0x53,0x5a,0x4b,0x54,0x43,0x64,0xba,0xcc,0x52,0xd2,0xcd,0x4c,0xac,0xb4,
+   0xad,0xcd,0x1c,0xb0,0x4c,0x71,0xec,0x4c,0xc8,0x9c,0x45,0xb3,0xbe,0x34,0xa5,0x3d,
+   0x3c,0x3c,0xbd,0x4b,0x3b,0xeb,0x33,0x55,0xbb,0xbc,0xd9,0x54,0xda,0x77,0x54,0xf4,
+   0x55,0xf7,0x20,0xe9,0x4b,0xd7,0x75,0x8c,0x87,0x85,0xb7,0x96,0x88,0xa7,0xc5,0x78,
+   0x96,0x6b,0x9a,0x3a,0x5b,0x99,0x86,0x77,0xc9,0x80
+   };
+
+static const unsigned char fixture_2_2_16[112]=
+   {
+   0x40,0x03,0xc9,0xac,0xba,0x97,0xc5,0xab,0xaf,0xd9,0x85,0x17,0x91,0x09,0x12,0xf3,
+   0x4d,0x12,0xd1,0x31,0x2c,0xd7,0x52,0xe9,0x35,0x69,0x2f,0x16,0x77,0x66,0xf6,0xd5,
+   0x12,0x94,0xf5,0x0f,0x50,0x9c,0xaf,0x15,0x0b,0x2d,0x36,0xcd,0x2f,0x6e,0xf3,0x12,
+   0xef,0x31,0x4b,0x4f,0x00,0x71,0x91,0xee,0x22,0x93,0x19,0xb2,0x19,0xa5,0xed,0x83,
+   0xec,0xf0,0x1f,0xc0,0x88,0xf6,0x12,0xc7,0x2c,0xd5,0x8b,0x0d,0x51,0x2d,0x4b,0x67,
+   0x4f,0x76,0x36,0xf9,0x10,0x76,0xf6,0x78,0xd3,0x2b,0x34,0xf0,0xd3,0x4a,0x2d,0x57,
+   0x6b,0xca,0xf1,0x8b,0x33,0xaa,0x8a,0x65,0xd6,0x88,0x76,0x89,0x9a,0x77,0xa4,0xa0
+   };
+
+static const unsigned char fixture_2_3_1[114]=
+   {
+   0x80,0x00,0x21,0xba,0x97,0x7a,0x8b,0x86,0xc7,0xa7,0x99,0x88,0xa9,0x6b,0x7a,0x98,
+   0x89,0x7b,0x69,0x89,0xa9,0x99,0x88,0x79,0xb8,0x69,0xb9,0x69,0xa9,0x6a,0x8a,0x7a,
+   0xa7,0x79,0xaa,0x87,0xb6,0x05,0x8c,0xbf,0x38,0xb7,0x3a,0x69,0x72,0x96,0x6b,0xac,
+   0x93,0x53,0x74,0xc9,0x2b,0xc5,0xab,0x6a,0x99,0x77,0xa9,0x7b,0x98,0x7a,0x8a,0x77,
+   0x9c,0x78,0x8b,0x87,0x8b,0x99,0x5b,0x82,0x58,0xc4,0x27,0xf0,0x9f,0xc2,0x81,0x09,
+   0xf4,0x38,0x30,0x20,0xc0,0x7f,0x02,0x0c,0x36,0x0e,0x5a,0x32,0x26,0x1e,0x9e,0x2e,
+   0x26,0x26,0x22,0xd6,0x9f,0x1e,0x25,0xe6,0xde,0x22,0xad,0x6a,0x5e,0xda,0xda,0x6e,
+   0x65,0xe0
+   };
+
+static const unsigned char fixture_2_3_3[111]=
+   {
+   0x80,0x00,0x95,0xa9,0x7c,0x47,0x68,0xe2,0xef,0x1b,0x53,0x9d,0x59,0x54,0x7d,0x57,
+   0xab,0x3d,0x49,0x79,0x86,0x53,0x51,0x27,0xe9,0x67,0x53,0x4c,0xd3,0x4f,0x13,0x0d,
+   0x4c,0x07,0x1a,0x04,0x4c,0x0e,0xd2,0xfd,0xbb,0xac,0xeb,0x42,0xf3,0x43,0x3d,0xbc,
+   0x43,0x5b,0xd2,0xcb,0x52,0xd5,0xc4,0xa4,0xbc,0x4a,0xdb,0x5b,0xcb,0x3d,0xd4,0x23,
+   0xcc,0x4c,0xbc,0x2d,0xcc,0xa5,0x36,0x10,0xac,0x72,0x0c,0x0c,0xcf,0xa2,0xbe,0x80,
+   0xfe,0x1b,0x86,0xd2,0xd6,0x55,0x1a,0xb2,0xd8,0x8e,0xdb,0x30,0x8f,0x75,0x0c,0xf5,
+   0x0c,0xd3,0x50,0xf3,0x2d,0x4b,0x6b,0x8b,0x31,0x4e,0xcf,0x4d,0x31,0x52,0x78
+   };
+
+static const unsigned char fixture_2_3_16[110]=
+   {
+   0x80,0x03,0xcb,0x2d,0x5e,0x91,0xdf,0x2c,0xb2,0x4d,0x6b,0x6c,0x13,0xc5,0x0a,0x08,
+   0x27,0xa4,0x74,0xfc,0x7a,0x96,0x22,0xcf,0x0e,0x62,0x1b,0x5d,0xde,0x25,0xd6,0xec,
+   0xb5,0xda,0xe0,0x8e,0x2e,0xf2,0x23,0xf8,0x4f,0x60,0xc4,0x76,0xfe,0x33,0xc8,0x30,
+   0x9d,0xc4,0xcc,0x8d,0x71,0xd4,0xcf,0x25,0x70,0xcd,0xec,0x96,0x6b,0xd9,0x17,0xaa,
+   0xa5,0x87,0xbc,0x85,0xa6,0x88,0x99,0x65,0x99,0x8a,0x03,0x8b,0x8f,0x4d,0xe6,0xfb,
+   0xab,0x53,0x31,0x05,0xb6,0x3d,0x2a,0xa4,0xcc,0xe7,0x57,0xe1,0xe3,0xab,0xb6,0x9b,
+   0x67,0x34,0xef,0x19,0x2b,0x2c,0xfa,0x90,0xf7,0x29,0x8c,0xf0,0xf6,0xf4
+   };
+
+static const unsigned char fixture_2_4_1[108]=
+   {
+   0xc0,0x00,0x0f,0x2c,0xe5,0xf2,0x7b,0x1d,0xf5,0x5b,0xea,0xd3,0x67,0x34,0x94,0xa3,
+   0xc6,0xa9,0x7a,0x7b,0xa6,0x98,0xaa,0x98,0xa8,0xa8,0x07,0x8d,0x3e,0x84,0x81,0x3b,
+   0xa4,0xd6,0xe9,0x25,0xd3,0x59,0x67,0x97,0x2d,0x2c,0x96,0x8f,0x78,0xd4,0xf3,0x36,
+   0xd7,0x53,0x2f,0x10,0x13,0x1a,0x87,0x05,0xe9,0x05,0x6d,0xbe,0xbe,0xbc,0x97,0xa8,
+   0x79,0xe4,0x4c,0xbd,0xb6,0x2d,0x53,0xcd,0xc5,0x3c,0x45,0xc5,0x53,0x5c,0x45,0x44,
+   0x02,0xc6,0x21,0x8e,0x4e,0xf9,0xa3,0x97,0x5c,0xaa,0x27,0x8d,0x35,0x4d,0x72,0xd7,
+   0x11,0x8b,0x53,0x35,0x2f,0x52,0xf6,0xf1,0x72,0xd7,0x13,0x6a
+   };
+
+static const unsigned char fixture_2_4_3[118]=
+   {
+   0xc0,0x00,0x99,0x39,0x7c,0x6a,0x5d,0x77,0x5a,0x7a,0x88,0xa3,0xc6,0x97,0x7b,0x87,
+   0x78,0x99,0x75,0xa7,0xb6,0x98,0x76,0xb7,0x97,0x8b,0x57,0x99,0x90,0x98,0xa4,0x28,
+   0x1a,0xca,0xa1,0xcc,0xba,0xb4,0xac,0xca,0xdd,0x13,0x23,0x9e,0x44,0x2c,0x5d,0x9d,
+   0xa7,0x25,0x28,0xb5,0x24,0xb9,0x67,0x22,0x0b,0x8d,0x3e,0x87,0xa1,0xea,0xd7,0x11,
+   0x6b,0x6b,0x2d,0x91,0x0b,0x6d,0x6b,0x4e,0xcf,0x4f,0x67,0xab,0x89,0x32,0xf6,0x96,
+   0x77,0x14,0xcf,0x4f,0x67,0x63,0x31,0x88,0x4f,0xf3,0xc0,0x7b,0x0a,0x0c,0x07,0xb0,
+   0x21,0xa6,0x72,0xd4,0xd0,0xf1,0x89,0x6f,0x0f,0x16,0x8f,0x33,0x4f,0x4c,0xb7,0x12,
+   0xcd,0x8e,0xeb,0x39,0x4e,0x80
+   };
+
+static const unsigned char fixture_2_4_16[116]=
+   {
+   0xc0,0x03,0xce,0x2c,0xed,0xda,0x4d,0x6b,0x7e,0xe3,0xf1,0xc3,0x49,0x54,0x2c,0xf1,
+   0xd9,0xb2,0x5a,0x8e,0xa6,0x60,0xf2,0x59,0xea,0x25,0xc1,0xe2,0xd0,0x21,0x8d,0x55,
+   0x57,0x4f,0xa6,0xe0,0xc0,0xed,0xa8,0x53,0x59,0xb7,0x72,0x7d,0x5c,0xd6,0xa5,0xeb,
+   0x56,0x56,0x2a,0xac,0x09,0x8b,0xc2,0x80,0xf4,0x62,0xb7,0x1c,0xa5,0xd8,0x60,0x5b,
+   0x43,0xd4,0x0e,0x66,0x62,0x1a,0x9b,0x18,0xea,0xda,0x9e,0xe1,0x9d,0x6d,0x79,0x62,
+   0x65,0xd6,0x68,0x1e,0x2a,0xfe,0x18,0xd6,0xd3,0x54,0x74,0xd4,0xd5,0x0b,0x81,0x76,
+   0x78,0x6e,0xa2,0x40,0x3a,0xda,0x61,0xa6,0x2d,0x63,0x16,0x22,0x57,0x19,0x6d,0xe6,
+   0x1e,0x25,0xdb,0x54
+   };
+
+static const unsigned char fixture_3_1_1[205]=
+   {
+   0x00,0x00,0x3f,0x73,0x0b,0xff,0x3a,0x07,0xd8,0xed,0x39,0xc4,0x64,0xd2,0xc2,0x28,
+   0xa1,0x0d,0x77,0x4e,0xf2,0xc5,0xb7,0xd0,0xd4,0xcb,0x56,0x7c,0x27,0x43,0x91,0xc8,
+   0x31,0xf4,0xee,0x7a,0x64,0x75,0x1f,0x7b,0x97,0x75,0x6f,0x5d,0x0d,0xaf,0xf9,0x4d,
+   0x14,0xf4,0xd2,0x1c,0x87,0x26,0xc0,0xf3,0x6b,0x48,0x68,0xd6,0x36,0x39,0x30,0xfa,
+   0x9c,0x22,0x6e,0x6c,0x91,0x23,0xfc,0xb3,0x8a,0x71,0xc7,0x06,0xff,0x40,0x90,0xe4,
+   0x09,0xe2,0xdf,0xa1,0xd8,0xc5,0xd2,0xf7,0x1f,0x5e,0xae,0x4e,0xa6,0xf7,0x41,0x8c,
+   0x90,0x6b,0x72,0x03,0x94,0x25,0xb3,0xf9,0x73,0xfc,0x62,0xdc,0x4b,0xae,0xaa,0xe7,
+   0x91,0xd1,0x91,0xc9,0x19,0x9c,0xdf,0xe5,0xd2,0xd8,0x18,0xff,0x4b,0x77,0xe5,0x68,
+   0x30,0x99,0x5e,0x96,0xce,0x5f,0xd9,0x1d,0xc1,0xe1,0x83,0xcd,0x31,0xb9,0x31,0x0e,
+   0x50,0x6b,0xba,0xbe,0xa7,0x06,0xf1,0x72,0x6a,0x69,0xfb,0xb2,0xac,0x95,0x71,0x3b,
+   0xad,0xd7,0xb6,0x37,0x0a,0x09,0x3a,0x8a,0x01,0xe4,0xa5,0x0f,0xb8,0x37,0x2a,0xcf,
+   0x83,0x18,0xb6,0x47,0x05,0x38,0x4e,0xac,0x93,0x24,0x1f,0x29,0x68,0x6d,0xf2,0x17,
+   0xd9,0x07,0x48,0x41,0xaa,0x69,0xac,0x32,0x38,0xf2,0xed,0x58,0xc8
+   };
+
+static const unsigned char fixture_3_1_3[205]=
+   {
+   0x00,0x00,0xbf,0xf3,0x71,0x90,0x6b,0xf6,0x15,0x62,0x0f,0x4b,0xeb,0xda,0xf9,0xd6,
+   0x52,0xa0,0xd2,0xa1,0xfc,0xf4,0x6e,0x40,0xa9,0xfd,0xa7,0x8d,0x89,0x3f,0xc3,0x90,
+   0xbe,0x8d,0x36,0x03,0xe5,0xeb,0x94,0x55,0xe7,0x78,0x0a,0x6e,0xeb,0xea,0x7e,0x64,
+   0x10,0x0a,0xa4,0xac,0x18,0x93,0x23,0xe2,0xc7,0x05,0xe8,0xfd,0x2c,0xf0,0x2a,0xfd,
+   0x8f,0xfe,0x6f,0x57,0xae,0x10,0x3d,0xb4,0x31,0xac,0xa4,0x05,0x45,0x25,0xda,0x6a,
+   0x27,0x6d,0x57,0x23,0x8f,0x47,0xd3,0x07,0x20,0x21,0x1c,0xe4,0x2d,0x90,0x7d,0xd6,
+   0xcf,0x5c,0x7d,0x3c,0xb5,0x4e,0xb4,0xb8,0xbb,0xe8,0x24,0x46,0xdf,0x75,0x06,0x00,
+   0x80,0xd0,0xc2,0x40,0x49,0x2a,0x13,0xc5,0xdd,0x86,0xfb,0x5a,0x63,0x78,0x94,0x24,
+   0x54,0xdf,0x59,0x3d,0xe6,0xc4,0xeb,0xbc,0x52,0xe7,0x84,0x9c,0xc2,0xf8,0xac,0x06,
+   0x4b,0xd1,0x17,0x47,0x7e,0x93,0x7c,0x93,0x85,0xb5,0xb7,0xef,0x1a,0x01,0x94,0x21,
+   0x83,0x8e,0x17,0xc5,0xa2,0xb0,0x42,0x46,0xd5,0x2c,0x1c,0xea,0x1b,0x05,0xcb,0xba,
+   0xf7,0x92,0x7a,0x8c,0x8a,0x69,0x7a,0x16,0x7c,0x89,0x04,0xd2,0x01,0x43,0x90,0x0e,
+   0xe7,0x10,0x80,0xe0,0x84,0xf1,0x5d,0x3e,0xc3,0x0e,0xb4,0xe3,0x18
+   };
+
+static const unsigned char fixture_3_1_16[205]=
+   {
+   0x00,0x03,0xff,0xf6,0x4e,0x5f,0xd0,0x9a,0x4d,0x67,0x3c,0x37,0x99,0xff,0x9c,0x7c,
+   0x1a,0xd4,0x6d,0x72,0xb0,0x64,0x8f,0x02,0x2b,0x93,0xb0,0x59,0xd4,0xe9,0x6f,0xe5,
+   0x99,0x89,0xdc,0xf3,0xba,0xbd,0x5a,0x96,0xad,0xb0,0x00,0x44,0x5b,0xc2,0x59,0x27,
+   0x22,0x38,0x54,0x6d,0x72,0x3a,0x55,0x79,0x41,0x14,0xa3,0x61,0x17,0xf7,0x79,0x9f,
+   0x04,0x37,0x07,0x31,0x47,0x1b,0x9f,0x8a,0x45,0xb1,0x79,0xd0,0x09,0x78,0xd1,0x4d,
+   0x1f,0x76,0x05,0x3f,0x69,0x11,0x38,0xd9,0x7b,0x76,0xa3,0x71,0x50,0x06,0x90,0x41,
+   0x53,0xf5,0x3e,0x77,0xd8,0x6a,0xf1,0x76,0xd2,0xb3,0xe0,0x54,0xdc,0x00,0x76,0x6b,
+   0xf1,0xa4,0xc3,0x0a,0x64,0xe9,0x09,0x42,0x9a,0xf9,0xa0,0x6a,0x9d,0x36,0x93,0xec,
+   0xc8,0xb4,0x69,0x3c,0xb1,0xd7,0xb2,0xd0,0x17,0x1d,0x2d,0xd4,0xf8,0xa4,0xea,0x42,
+   0x24,0xf2,0x39,0x1f,0x73,0x9d,0x70,0x71,0xad,0x2f,0xdf,0x62,0xa3,0x3b,0xcd,0xe9,
+   0x28,0x44,0x9d,0x25,0x07,0xf2,0x87,0x2b,0x0e,0xca,0xea,0xf5,0x1a,0x54,0x10,0xa5,
+   0xed,0x31,0x45,0x45,0x66,0xe2,0xe6,0xe8,0x4b,0xf6,0x38,0x9c,0x66,0x05,0x96,0x70,
+   0x93,0xa0,0x45,0x78,0x90,0x56,0x9f,0xb9,0x4c,0xad,0xe8,0x50,0x7c
+   };
+
+static const unsigned char fixture_3_2_1[205]=
+   {
+   0x40,0x00,0x3f,0x79,0xc3,0x69,0x6e,0xdc,0x40,0xae,0x75,0x34,0xd7,0x09,0x55,0x31,
+   0x79,0x34,0x1c,0xbf,0x6f,0xef,0x0f,0x31,0xd9,0xb0,0x36,0x91,0xeb,0x73,0xe2,0x6e,
+   0xcf,0xcc,0x48,0x6d,0xa7,0x61,0x74,0x49,0xb8,0xe1,0xc7,0x94,0x41,0x01,0x5a,0x24,
+   0x62,0x7a,0x49,0xb7,0x35,0xfc,0xc9,0xd0,0x0a,0x2f,0x34,0x37,0xf3,0xbd,0x88,0x9e,
+   0x4d,0x5a,0x0c,0xa8,0x17,0xbc,0xfb,0xf0,0xa9,0x84,0x68,0x79,0x0f,0x74,0x99,0x98,
+   0x9c,0x27,0xcd,0x1c,0x68,0x7d,0xf6,0xc7,0x92,0xfd,0x80,0x33,0x70,0x42,0x89,0x2f,
+   0x3b,0x3f,0x37,0x3f,0xf4,0x5b,0xd6,0x2d,0x9c,0xf6,0x4f,0x9c,0x96,0xda,0x70,0x75,
+   0xa9,0x1d,0x5a,0x48,0xe8,0x75,0x60,0xf3,0xc7,0xf6,0xf6,0x91,0xa8,0x94,0x8a,0xfc,
+   0x09,0x39,0x5f,0xa3,0x02,0x95,0xb0,0xd9,0x74,0x7b,0x13,0xe4,0x8d,0x90,0xa3,0x66,
+   0x46,0x38,0x25,0x6c,0x22,0x4a,0xd7,0x9b,0x19,0x1d,0x73,0x0f,0xa1,0x98,0x2c,0x61,
+   0xc2,0x0e,0xcf,0xb0,0xf0,0x5c,0x84,0x98,0x29,0xe4,0x1a,0x35,0xeb,0x7b,0xc7,0x20,
+   0x29,0x81,0x41,0x74,0x6b,0xd1,0xca,0xd7,0xa5,0xc6,0x18,0x56,0x5e,0x3a,0x6e,0x9c,
+   0x7f,0x92,0x85,0xb9,0x97,0x9d,0x95,0x50,0x97,0xc6,0x60,0x7b,0xf8
+   };
+
+static const unsigned char fixture_3_2_3[205]=
+   {
+   0x40,0x00,0xbf,0xfa,0x3a,0x33,0x2c,0x74,0x61,0x9a,0xc8,0xdb,0x17,0xaf,0xb8,0xa7,
+   0xe3,0xe8,0x0d,0xe9,0x58,0xba,0x33,0x1d,0xd8,0xec,0x92,0xd3,0xd6,0xc5,0xd7,0x79,
+   0xf4,0xdc,0x7b,0x9e,0xa5,0x86,0xe9,0x90,0x7b,0x7b,0xbc,0x1d,0xd9,0x11,0x4d,0x75,
+   0x50,0xfe,0x38,0x65,0x55,0x88,0xe7,0x3c,0x79,0x48,0x14,0x79,0x2e,0xb1,0xfa,0xc9,
+   0xd8,0x6d,0x24,0x8d,0x38,0xc0,0x3c,0x21,0x92,0x51,0xac,0x45,0x97,0xa7,0xcf,0x67,
+   0x9b,0x29,0x5f,0xe6,0x5f,0x4c,0xb8,0x40,0x16,0xa8,0x83,0x23,0x63,0xb3,0x0b,0x1e,
+   0xc9,0x02,0xea,0x60,0xb8,0xfe,0x8b,0xc5,0x1a,0x1a,0x4c,0x66,0xb4,0x6f,0xb4,0x2c,
+   0x29,0xff,0xf0,0x90,0x4b,0x92,0xf7,0x9f,0x4a,0x0d,0x11,0x75,0xb5,0x83,0x26,0xb0,
+   0x5e,0x99,0x69,0x3f,0xf2,0xd9,0x79,0x1d,0x54,0xe2,0xf2,0x2b,0xf1,0x44,0x3a,0xa9,
+   0xeb,0x29,0x6b,0xbd,0x55,0xb2,0x9a,0x84,0x5b,0xff,0xf8,0x1d,0x15,0x29,0x9d,0xa5,
+   0xac,0x57,0xb0,0x38,0x3c,0xa2,0x49,0x06,0xe9,0x2d,0x8d,0x1b,0xd1,0x19,0x99,0xa5,
+   0x0b,0x8e,0x8f,0xc0,0xbf,0x98,0x8c,0x91,0x0c,0x6b,0xad,0x30,0x15,0x1c,0x1e,0xbf,
+   0xf8,0xcd,0xfa,0x5a,0xd2,0xa5,0x59,0x2e,0xbd,0xbe,0x60,0x51,0xe8
+   };
+
+static const unsigned char fixture_3_2_16[205]=
+   {
+   0x40,0x03,0xff,0x7d,0x06,0x62,0x6d,0x51,0xd2,0xac,0x35,0xfe,0xc1,0x9c,0xa8,0xec,
+   0xd6,0x28,0x28,0x57,0x62,0xe6,0xce,0xbe,0x17,0x53,0xeb,0xff,0x1b,0x96,0xb5,0x11,
+   0xd7,0x77,0x61,0xde,0x43,0x3d,0xba,0x6c,0x96,0x91,0xd6,0xb4,0x99,0xbb,0xce,0xce,
+   0x44,0xb3,0x5a,0x81,0xdf,0x60,0xb2,0x17,0x01,0xdb,0xdd,0x66,0x04,0x0c,0xa4,0x76,
+   0xcd,0xfb,0x4f,0x41,0x47,0x9f,0xa5,0xed,0x79,0x11,0xb0,0x33,0x7a,0x39,0xa6,0x3b,
+   0x43,0x1f,0x40,0x0c,0xbb,0xda,0xa5,0x80,0x0c,0x33,0xce,0xdc,0xfc,0x72,0x93,0xfb,
+   0xa4,0x6f,0x3c,0xc4,0x3c,0x01,0x91,0x4f,0xdc,0x8a,0x17,0x1c,0x1c,0x9f,0xe2,0x52,
+   0xc7,0xc0,0xbf,0x3c,0x25,0x35,0xf9,0x04,0x13,0x38,0x65,0x7a,0x7a,0x02,0x23,0xba,
+   0x95,0x99,0x5f,0xa8,0xae,0x5f,0x7d,0x7a,0x9f,0xc6,0xc3,0xfc,0xb8,0xe1,0x35,0x31,
+   0x03,0xa8,0xdf,0x15,0x7e,0x27,0xb3,0xa4,0x2a,0x53,0xb4,0xe7,0x0a,0x2a,0xec,0xd0,
+   0x1f,0xb3,0x51,0x75,0x58,0xea,0xe8,0xc4,0xc7,0xd7,0xac,0xc8,0x66,0x6b,0xa7,0x7e,
+   0x2e,0xb4,0xca,0xdc,0x2e,0xad,0x1c,0xf0,0x5c,0x56,0xa7,0xac,0xb9,0xb7,0x55,0x23,
+   0x44,0xbd,0x43,0x42,0x07,0x76,0x54,0x16,0xef,0xe0,0x95,0x98,0x0c
+   };
+
+static const unsigned char fixture_3_3_1[205]=
+   {
+   0x80,0x00,0x3d,0xf0,0x8d,0x56,0xed,0x19,0x27,0x3d,0xa5,0xaf,0x1d,0x9a,0xcd,0x22,
+   0x0c,0xb2,0x25,0x8d,0x10,0xfc,0xa0,0xca,0xe3,0x88,0xc6,0x6e,0x17,0x7b,0x98,0x9a,
+   0x86,0xf2,0x08,0x8e,0x40,0x01,0xac,0x2a,0xb1,0x89,0x82,0xed,0x18,0x73,0xba,0x58,
+   0x2c,0xa5,0xc3,0xac,0xbd,0xd1,0xe8,0x92,0xc0,0xa8,0x40,0x12,0x7b,0xd7,0x53,0xad,
+   0x44,0xfd,0x84,0x46,0xad,0x99,0xec,0xaf,0xe4,0xe6,0xcd,0x34,0x55,0xf3,0xe2,0x63,
+   0xd6,0xe7,0xc7,0x54,0xa4,0x5f,0x0b,0x66,0x39,0xc6,0x15,0xa9,0xee,0xd9,0xd9,0x6c,
+   0xb3,0xd9,0x2b,0x7f,0x6f,0x55,0x66,0xf0,0x2a,0xa3,0x92,0xc3,0x5e,0xdd,0xb5,0xdc,
+   0x52,0x62,0xfc,0xd6,0xf5,0x49,0xbe,0xb0,0x0e,0x9f,0xc1,0xde,0xa9,0x6b,0x99,0xbc,
+   0x4b,0x40,0x6b,0x60,0x30,0x68,0x50,0x14,0xf2,0x07,0x3e,0x7b,0x5d,0x56,0xeb,0x09,
+   0x3b,0x8b,0x94,0xfd,0xa8,0x08,0xa6,0x10,0xec,0xde,0x9d,0xcd,0x97,0x2d,0x6e,0x71,
+   0xd1,0x5b,0xd5,0x18,0xad,0x5e,0x7a,0x27,0x52,0xef,0x55,0x4a,0x3d,0xdc,0xc9,0xf6,
+   0x90,0x48,0xfb,0x7f,0x4c,0xcd,0x0d,0x62,0x84,0xdc,0x63,0x92,0xae,0xf7,0xc6,0xaf,
+   0xcc,0xe0,0xd8,0x30,0xdd,0xed,0x2e,0xd4,0xd9,0x41,0x8e,0xb8,0x28
+   };
+
+static const unsigned char fixture_3_3_3[205]=
+   {
+   0x80,0x00,0xbf,0xf0,0xf6,0x1c,0x5c,0x62,0xd0,0xa0,0x9e,0xce,0x42,0xbf,0x07,0x72,
+   0xb4,0x4c,0x79,0xcc,0x07,0xd5,0xf4,0x1f,0x4a,0x37,0xac,0xa6,0xee,0x69,0x1e,0x2e,
+   0x79,0xc9,0x03,0x9e,0xcf,0xe9,0x54,0x1a,0x0e,0x7b,0x5f,0x17,0x79,0xab,0x88,0x4f,
+   0xe7,0x9d,0x93,0x88,0xed,0x08,0x81,0x11,0xd8,0x82,0xa9,0x3f,0x0f,0x5d,0x58,0xb5,
+   0xf8,0xa1,0x5c,0x89,0xaa,0x0a,0xa0,0xd6,0x10,0x87,0xbe,0xa6,0x62,0x8e,0xbd,0xeb,
+   0x12,0x86,0x47,0x39,0x81,0x38,0x0f,0x6f,0x3d,0xf4,0x8b,0x67,0x26,0x4f,0xdc,0x55,
+   0x42,0x0d,0x3b,0xa3,0x1f,0x1b,0x36,0xeb,0x3d,0xef,0x6c,0x35,0x5d,0x12,0xd5,0xa2,
+   0xb5,0x3d,0xc5,0xa9,0xa5,0x83,0xb2,0xd1,0xcf,0x2f,0x64,0x30,0x01,0xce,0xbc,0xc2,
+   0x67,0x2f,0x09,0x3e,0x0f,0x0f,0xd6,0x29,0x84,0x8f,0x24,0xad,0x6c,0x5a,0x82,0x6b,
+   0x6f,0x19,0xaa,0x78,0xce,0xb7,0x0d,0xcd,0xe6,0xb8,0x01,0xc3,0x8a,0x06,0x86,0x6f,
+   0xa7,0xb5,0x35,0xc0,0x3e,0x42,0x2a,0x82,0x56,0x76,0x1b,0x35,0x06,0x6b,0x49,0x40,
+   0x7c,0x7c,0x8f,0xd0,0xf6,0x70,0x42,0xe9,0xb8,0x43,0x62,0x50,0x2b,0x4c,0x6c,0xaa,
+   0xa9,0x36,0x7a,0x67,0xba,0xf4,0x1c,0xc4,0xdf,0xda,0x98,0xd1,0xb4
+   };
+
+static const unsigned char fixture_3_3_16[205]=
+   {
+   0x80,0x03,0xff,0xf3,0xc6,0xe7,0xc7,0xe3,0xae,0x3b,0xf5,0x21,0xfd,0x17,0xda,0x10,
+   0xae,0xe3,0x1f,0x02,0xb2,0x51,0x5d,0x2b,0xf6,0x8a,0x71,0x96,0x19,0x6d,0x8f,0x9a,
+   0x89,0xb8,0x3f,0xc9,0x2a,0x1c,0x7f,0x05,0x71,0x6f,0xee,0x17,0x5a,0x5c,0x51,0x8a,
+   0xa3,0x9f,0x82,0x5e,0xf0,0x1b,0x0d,0x18,0x36,0x64,0xc2,0xbd,0xf1,0x56,0x77,0xdc,
+   0x1f,0xcd,0xc5,0x32,0x34,0x3c,0xbe,0xcc,0x49,0x50,0xfd,0x67,0xde,0x33,0x3a,0x53,
+   0x7a,0x94,0xc2,0x63,0x59,0x38,0xe4,0x09,0x6e,0xf0,0x7a,0xa0,0x0e,0x0b,0xc3,0x8a,
+   0x81,0xec,0x6a,0x20,0x95,0x7b,0xd3,0x5e,0x07,0x68,0x07,0xb2,0x8a,0x72,0xc4,0x21,
+   0xc5,0x71,0xa9,0x53,0xa3,0x1e,0x7c,0x13,0xd2,0x17,0x05,0x02,0x35,0x3c,0xe1,0x12,
+   0x43,0x46,0x19,0x3c,0x37,0x01,0xbb,0x12,0x46,0xbf,0xc0,0x3f,0xba,0xce,0x86,0x6b,
+   0x31,0x1b,0xcb,0x36,0x0e,0x39,0xaf,0xf4,0xa3,0xc5,0x50,0xf7,0xd1,0xb0,0x68,0x1b,
+   0x87,0x93,0x11,0x6d,0x84,0xb9,0x7f,0xe1,0x0a,0x19,0x5c,0xe6,0x39,0x99,0x72,0xde,
+   0x56,0x2d,0x55,0x4b,0x7b,0xc9,0xc8,0x90,0xdf,0x54,0x76,0x22,0xc2,0xc8,0x04,0x76,
+   0x31,0x14,0x36,0xf1,0x82,0x21,0xa6,0x0f,0xce,0xea,0x17,0x35,0x44
+   };
+
+static const unsigned char fixture_3_4_1[205]=
+   {
+   0xc0,0x00,0x3f,0xf7,0x44,0x60,0xc0,0xbc,0xa6,0xc6,0xc6,0x6c,0xeb,0x78,0xed,0xe0,
+   0xc1,0x86,0x26,0x47,0x27,0xfd,0x9e,0x7f,0x3d,0xce,0x05,0x97,0xd1,0xe6,0x9a,0x90,
+   0x13,0x66,0x5c,0x56,0xf1,0x4c,0x1a,0x0b,0x8a,0x77,0x02,0x8c,0x9e,0x16,0x04,0xf9,
+   0x3b,0x18,0x20,0x20,0x90,0x54,0x1d,0xbc,0x2e,0xfd,0x45,0x27,0x12,0x91,0xd5,0xb1,
+   0xf8,0xe7,0xc2,0x7f,0xb4,0xe2,0x1e,0x73,0x69,0x83,0xec,0x80,0x09,0xd0,0x1f,0xd8,
+   0x88,0xd9,0xcb,0x30,0x09,0x83,0xc1,0xd9,0x7e,0xc1,0x46,0xa7,0xbb,0xd5,0x2c,0xad,
+   0xf3,0x72,0x76,0xcf,0x18,0xdc,0x38,0x18,0x40,0xd3,0x30,0x7e,0x32,0x1d,0x48,0xb1,
+   0x23,0x16,0xdc,0x27,0x0a,0xd6,0xd1,0xe6,0xe0,0x54,0x40,0xe7,0xca,0x76,0x40,0x10,
+   0xa0,0x63,0xb9,0x3d,0xa2,0x1e,0x44,0xee,0xc9,0x92,0xdf,0x49,0x40,0x47,0xa9,0xc2,
+   0xcb,0xfa,0x62,0x19,0x22,0x68,0xca,0x12,0x09,0x58,0x9e,0x0a,0x95,0x83,0x01,0x60,
+   0x0e,0xa4,0x01,0x24,0x47,0xbd,0x24,0x3e,0x03,0x85,0x2d,0x6b,0xfc,0xc6,0xd7,0x68,
+   0xfe,0x34,0xdc,0xff,0xc6,0x9a,0x08,0xe3,0x0c,0xb1,0x1d,0xd9,0x97,0x38,0xd2,0xa2,
+   0x24,0xf7,0xea,0x03,0x74,0xa5,0x22,0xb0,0x49,0x0b,0x3f,0x7b,0x5c
+   };
+
+static const unsigned char fixture_3_4_3[205]=
+   {
+   0xc0,0x00,0xbf,0xf7,0xb4,0xf8,0xbd,0x8c,0xe3,0xa9,0xa2,0x95,0x5d,0x59,0xcd,0xd1,
+   0x0e,0x35,0x18,0x6f,0xe6,0x7b,0x92,0x42,0x05,0xed,0x5b,0x57,0x7c,0xaa,0x53,0xb0,
+   0x0a,0x92,0x9b,0x5b,0xff,0xc6,0x12,0x2b,0x2c,0x34,0xe8,0x3d,0x8f,0xfe,0xdd,0x93,
+   0x1a,0xf4,0x22,0x3c,0x0d,0x1c,0xf7,0xba,0x10,0x0f,0xf4,0x65,0x34,0xa8,0xfc,0x7d,
+   0x5d,0xd4,0x3a,0xdf,0xb5,0x41,0xbf,0x5c,0x6a,0xe1,0x8a,0x23,0x4e,0xe3,0x7b,0x34,
+   0x51,0x27,0xc2,0x8f,0xb1,0x8e,0x50,0x15,0x50,0x37,0x03,0xf5,0x3d,0x22,0x0d,0xff,
+   0x68,0x6f,0x4e,0x53,0xa1,0xde,0xc4,0xe3,0x27,0xa7,0x10,0x00,0xc1,0x70,0xd3,0xf4,
+   0x2e,0xc4,0xdb,0xec,0xd5,0x36,0x24,0xfa,0xd4,0xf4,0xbf,0x4d,0xfd,0xf0,0x8a,0xf6,
+   0x60,0x29,0x99,0x3d,0xf1,0x06,0xeb,0xf5,0x7d,0xbc,0x1c,0xd5,0x57,0xcb,0x9d,0x09,
+   0x7b,0x25,0x68,0x91,0xef,0xd1,0x8b,0x66,0xb5,0xcf,0xf6,0xa8,0xae,0x64,0x99,0x27,
+   0xad,0x71,0x88,0x05,0xe9,0x55,0x4d,0xec,0x3a,0x4b,0x26,0xe6,0x98,0x4b,0x0e,0xed,
+   0x0b,0x59,0x06,0x0b,0x87,0x7d,0x08,0x36,0x10,0xb3,0x1d,0x70,0xae,0xf7,0x45,0xbb,
+   0x62,0x41,0x81,0x12,0x1e,0xa5,0xc3,0x80,0xe8,0x18,0x14,0xfb,0xcc
+   };
+
+static const unsigned char fixture_3_4_16[205]=
+   {
+   0xc0,0x03,0xff,0xfa,0x80,0x64,0xd0,0x67,0x64,0xa5,0xd7,0x60,0x7f,0x13,0xbe,0x08,
+   0x02,0xa1,0x97,0x50,0xea,0x15,0x8d,0xfe,0xe4,0xbb,0x4e,0x9a,0xab,0x5d,0x0b,0x42,
+   0x4e,0x1a,0xb3,0xe6,0x0c,0xc4,0x58,0xa5,0xb7,0x7a,0x09,0x41,0x6e,0x3b,0xb5,0xf9,
+   0x10,0xd9,0x6e,0xbc,0xcf,0x8f,0x7c,0xdc,0xfa,0xbe,0xf4,0x25,0x0d,0xdb,0x9c,0x6f,
+   0x34,0x3c,0x39,0xbf,0x61,0x88,0xb6,0x89,0x39,0x73,0xa3,0x75,0x14,0x7d,0x9c,0x6d,
+   0x0b,0x53,0x91,0x50,0xfe,0x45,0x72,0x50,0xdd,0x43,0x6f,0x3c,0xe8,0x3d,0x48,0x34,
+   0xcf,0x23,0x3d,0x28,0xb2,0x15,0x2e,0x1d,0x06,0x39,0xc8,0xff,0x66,0x22,0xd8,0x36,
+   0x59,0xdc,0x95,0x58,0x05,0x5b,0x34,0x44,0x27,0x7b,0xeb,0x11,0x09,0xa1,0x03,0x4c,
+   0x27,0xe2,0x39,0x3d,0xdc,0xd8,0x83,0xdd,0xe5,0xa6,0x0e,0x2c,0xf1,0x6e,0x9b,0x7a,
+   0xfc,0x3e,0x23,0xc4,0x0e,0x04,0xb3,0x0c,0x1a,0xd2,0x42,0xc2,0x01,0x04,0x55,0xc5,
+   0x85,0xef,0xad,0xa0,0xec,0xfb,0x6c,0x1d,0x3f,0x28,0x88,0xd4,0x9b,0x16,0x85,0xe4,
+   0x34,0x71,0xa6,0xbe,0xd0,0xd3,0xbe,0x9c,0x6c,0x2c,0xd9,0x79,0x06,0x88,0xf7,0x54,
+   0xa7,0xe4,0x0c,0x37,0x3c,0x42,0x2c,0x0c,0xdb,0x9f,0x4a,0xe9,0x78
+   };
+
+static const unsigned char fixture_4_1_1[82]=
+   {
+   0x00,0x00,0x15,0x1a,0xb6,0xeb,0x9b,0xda,0xdf,0x6d,0xee,0x9b,0x7e,0x6a,0x24,0xb4,
+   0x8e,0x4b,0x2b,0xb1,0xd9,0x2c,0x05,0xf1,0x8e,0x83,0x97,0xb6,0xc2,0x81,0xe7,0x7e,
+   0x6b,0xab,0x60,0x93,0x84,0x94,0x0d,0x17,0x77,0xab,0x7a,0xdd,0xbe,0xa6,0x1e,0xb3,
+   0x92,0xc7,0x64,0xb1,0xcc,0x1d,0x49,0x23,0x98,0x28,0x68,0x9d,0xae,0x57,0x33,0xb2,
+   0x39,0x9c,0x96,0x4a,0xe5,0x75,0xe7,0x5c,0xb2,0xc7,0x5c,0xb5,0xd7,0x2b,0xb0,0x17,
+   0x3e,0xc3
+   };
+
+static const unsigned char fixture_4_1_3[103]=
+   {
+   0x00,0x00,0x8f,0x2b,0x1c,0x9a,0x47,0x2c,0x6e,0xd9,0x1c,0x7d,0xc7,0x63,0xac,0x28,
+   0x0a,0x7d,0x60,0xf3,0x28,0x7a,0x31,0x17,0x86,0x35,0xe2,0x2f,0x74,0x1b,0x04,0x6f,
+   0x47,0xc9,0x2d,0xc2,0xb4,0x98,0xb2,0x91,0xc9,0x5e,0x51,0xe9,0x55,0x72,0x4a,0xc4,
+   0x1a,0xae,0xc0,0xa0,0x22,0xd1,0xb1,0x46,0xab,0x73,0x83,0x2d,0x1a,0x94,0x2e,0xc0,
+   0x85,0xfa,0x2b,0xc3,0x95,0x76,0x48,0xe3,0xd2,0x9a,0x95,0x49,0x25,0x72,0xbc,0xb2,
+   0x8e,0xe6,0xdd,0x92,0xd8,0xd5,0x7d,0xc7,0x20,0x16,0xf6,0x69,0x1e,0x5e,0xe1,0xdc,
+   0x51,0xaa,0xe6,0xa0,0x8b,0x2c,0x40
+   };
+
+static const unsigned char fixture_4_1_16[94]=
+   {
+   0x00,0x03,0xc7,0x1a,0xad,0xf7,0x6a,0x26,0xb4,0x72,0x57,0x5b,0xce,0x4b,0x14,0xa1,
+   0x41,0x95,0x5c,0x7a,0x3b,0x23,0xb2,0x3a,0xeb,0xca,0xc7,0x01,0x72,0x1e,0x11,0xc9,
+   0xb7,0x5e,0x8d,0xe6,0xed,0x07,0xf7,0x88,0x20,0x61,0xa9,0x34,0x32,0xd7,0x32,0x92,
+   0xbd,0x13,0xce,0x58,0xe4,0x96,0x39,0x1d,0x7a,0x37,0x9d,0x75,0xc7,0x34,0xaa,0x4a,
+   0xad,0x8d,0xe7,0x60,0x2b,0x79,0xe2,0xcf,0xbe,0xad,0xc1,0xec,0x4f,0x3e,0x8e,0x10,
+   0xbe,0x7d,0x49,0x1c,0xba,0x29,0x2b,0xb2,0x46,0xed,0x8a,0xd5,0x65,0x6c
+   };
+
+static const unsigned char fixture_4_2_1[89]=
+   {
+   0x40,0x00,0x0e,0x1a,0xee,0xb9,0xeb,0xe6,0xef,0x9e,0xd4,0x2b,0x39,0x6b,0xb6,0x49,
+   0x5c,0xb5,0xcb,0x26,0x72,0xc9,0x6c,0x8f,0x06,0xc7,0x71,0xc1,0x80,0xfe,0x00,0x23,
+   0xe1,0x41,0xa5,0x6b,0xb2,0x4d,0x1e,0x76,0x49,0x6b,0x92,0xcb,0x20,0x1a,0x23,0x95,
+   0x26,0x72,0xc9,0x2d,0x8e,0xd9,0x2b,0xb2,0xcb,0x23,0xb2,0xd9,0x1e,0x76,0x4b,0x2b,
+   0xb2,0xc9,0x2c,0xb2,0x4a,0xc1,0xe1,0x7d,0xe0,0x06,0x4e,0xd8,0xf1,0x83,0x55,0xbe,
+   0xdd,0x7d,0x75,0xcc,0x25,0x67,0x33,0x92,0xc0
+   };
+
+static const unsigned char fixture_4_2_3[89]=
+   {
+   0x40,0x00,0x8c,0x9d,0xee,0xb5,0xba,0xb4,0xef,0x60,0x12,0xec,0x5a,0x92,0x45,0xa4,
+   0x95,0x86,0x04,0x4b,0x7b,0xad,0x75,0x94,0x9d,0x67,0x56,0x39,0xd9,0x63,0x92,0x3a,
+   0xe4,0xb5,0xd5,0x2d,0x71,0xe5,0x5d,0xb0,0x45,0x0d,0xf8,0x3d,0x81,0xf7,0xe2,0x20,
+   0xa4,0x79,0xc9,0x1c,0xb5,0x65,0x82,0xed,0x45,0x5f,0x94,0xda,0xe1,0x57,0x55,0x76,
+   0x3d,0x22,0xae,0x5a,0xdc,0xcb,0x3a,0xa5,0x76,0x55,0x2d,0x71,0xc9,0x65,0x91,0x58,
+   0xeb,0xab,0x05,0x02,0x93,0xb2,0x49,0x56,0x60
+   };
+
+static const unsigned char fixture_4_2_16[117]=
+   {
+   0x40,0x03,0xc9,0x1a,0xae,0xbe,0xab,0xad,0x04,0xb3,0x1e,0x6a,0x9a,0xea,0x9c,0x66,
+   0xba,0xb2,0x3b,0x5b,0x92,0x59,0x1c,0xb1,0x76,0xdf,0x6e,0xb9,0x25,0x5a,0x37,0x72,
+   0xb2,0x3b,0x5d,0x60,0xf0,0xba,0x78,0x82,0x9d,0xa0,0x15,0x3f,0x30,0x87,0x34,0x9e,
+   0x47,0x0b,0x92,0xf3,0xb0,0x60,0x3f,0x81,0x0a,0x92,0xd7,0xf0,0x9f,0xc0,0xb9,0x06,
+   0x00,0x62,0xf4,0xe1,0xb8,0x6f,0x9b,0xf4,0x13,0xfc,0x00,0xa5,0x6a,0x95,0xbd,0x18,
+   0x2f,0xe6,0x1a,0x69,0x57,0x9c,0x56,0xca,0xd6,0x91,0xd8,0xde,0xab,0x26,0x17,0xf8,
+   0x09,0xbf,0x40,0x40,0x8b,0x52,0x39,0x95,0xa7,0x50,0x9c,0x47,0xb1,0x32,0xd8,0x5a,
+   0x56,0xc7,0x63,0x7d,0x00
+   };
+
+static const unsigned char fixture_4_3_1[99]=
+   {
+   0x80,0x00,0x0c,0x29,0x26,0x79,0xe9,0x25,0xae,0xd7,0x66,0x76,0x40,0x7c,0xdf,0x2a,
+   0x08,0x79,0x7a,0xfe,0xab,0xf4,0xca,0xd1,0xdb,0x25,0xb2,0xbc,0xec,0xb5,0xe7,0x64,
+   0xa0,0xa8,0x90,0x04,0x3e,0xe0,0xb7,0x71,0x68,0x0b,0xef,0xd7,0xd7,0x5f,0x6f,0x7b,
+   0xf7,0xb1,0xb5,0x9d,0x96,0xcb,0x2c,0x95,0xd9,0x65,0x96,0x4d,0x2c,0x03,0x43,0x08,
+   0xad,0x78,0x20,0x06,0xb4,0xa0,0xbf,0xc8,0x39,0xd5,0x5d,0x9a,0x49,0x65,0x96,0x4b,
+   0x5d,0xb2,0xbc,0xed,0x74,0x27,0xcc,0x89,0x2d,0x81,0x26,0xa4,0xaf,0x3d,0x1e,0x79,
+   0xe8,0xed,0xa0
+   };
+
+static const unsigned char fixture_4_3_3[108]=
+   {
+   0x80,0x00,0x83,0xaa,0xe6,0x98,0x88,0xfe,0x41,0xe6,0x8b,0xbd,0xd9,0xe6,0x50,0x4d,
+   0x12,0x75,0xf3,0x96,0x92,0x2c,0xb2,0xb5,0xd5,0x65,0xaa,0xb9,0x25,0x75,0xc9,0x2a,
+   0xea,0xab,0x2c,0x6e,0x04,0xa3,0x3f,0x07,0x8b,0x95,0x6f,0x4a,0x64,0xb9,0x55,0x9c,
+   0xb2,0x99,0x6c,0x59,0xc9,0x32,0xc9,0xd9,0x56,0x75,0x66,0x1d,0x49,0x25,0x78,0x51,
+   0x33,0xdd,0xd1,0x5d,0x8e,0x02,0x04,0xf3,0x89,0xf7,0x88,0x7a,0x06,0x00,0x3a,0xb5,
+   0xa9,0x38,0x79,0xc2,0x34,0x7d,0x8c,0x88,0x25,0x55,0xaf,0x2a,0xe5,0x56,0x51,0x37,
+   0x03,0xe1,0x3f,0x17,0xa2,0x7a,0x22,0x25,0xda,0x9e,0xed,0x2f
+   };
+
+static const unsigned char fixture_4_3_16[104]=
+   {
+   0x80,0x03,0xc5,0x1d,0xbe,0xf9,0x72,0xb3,0xcf,0x3b,0xa3,0x79,0x4b,0x5d,0x59,0x65,
+   0x25,0xa7,0x47,0x2c,0x76,0x3b,0x62,0xb6,0x39,0x1c,0xb1,0xda,0x70,0x1a,0x20,0xd2,
+   0xe7,0x6f,0x9c,0x06,0xb1,0xbd,0xf3,0xd0,0x44,0x6c,0xb9,0xb5,0xd5,0x3d,0x3e,0x6f,
+   0x50,0x25,0x69,0x55,0x8a,0xd1,0x18,0x47,0x88,0x0f,0xe0,0x42,0x7f,0x00,0x19,0x7c,
+   0x4e,0x43,0x06,0x13,0xf8,0x1d,0xc4,0xc0,0x7e,0x1d,0x49,0x8e,0x54,0x15,0xf9,0xf1,
+   0x8a,0x47,0x95,0xb1,0xbc,0x82,0x7c,0xe3,0x28,0x18,0x01,0x84,0xfb,0x37,0x78,0x17,
+   0x33,0xcd,0x24,0x5f,0xa3,0xa7,0xdd,0xcc
+   };
+
+static const unsigned char fixture_4_4_1[99]=
+   {
+   0xc0,0x00,0x06,0x9b,0xbe,0xbe,0xf5,0x2a,0xd5,0xe7,0x66,0x92,0xd9,0x65,0xb2,0xd9,
+   0x65,0x93,0x3b,0xa5,0x76,0xca,0x06,0x88,0xc5,0x5a,0xf5,0x96,0x4b,0x2c,0xb6,0x4d,
+   0x65,0x96,0x5b,0x2b,0xb6,0x69,0x26,0x9d,0x4c,0xf4,0x9a,0x40,0x74,0x58,0x21,0x28,
+   0xa4,0xd2,0xc9,0x6d,0x76,0xd9,0x6b,0xb0,0x26,0x17,0xe2,0x04,0x12,0x26,0xbe,0xeb,
+   0xef,0xba,0x08,0xb5,0x74,0x27,0x17,0xea,0x65,0x80,0x4e,0xad,0x95,0xdc,0xec,0xcf,
+   0x57,0xa5,0x96,0xbb,0x34,0x96,0xc9,0x65,0xce,0xda,0x13,0xf1,0x8f,0x40,0x40,0x85,
+   0x52,0x67,0x80
+   };
+
+static const unsigned char fixture_4_4_3[94]=
+   {
+   0xc0,0x00,0x89,0x1e,0xed,0xae,0x6b,0xd8,0x40,0xb3,0xd1,0xb7,0xa4,0xaa,0xad,0x24,
+   0x79,0xc5,0xa4,0x76,0xa9,0x03,0xd1,0x5f,0x83,0xd8,0x21,0x79,0x5a,0xc7,0x9e,0xb3,
+   0x72,0x59,0x2a,0xaf,0x38,0xe4,0x96,0x48,0xeb,0xb5,0xc7,0x24,0xb6,0x01,0xa1,0x02,
+   0x01,0x6f,0xcf,0xc0,0xfc,0x0a,0x93,0xb6,0x47,0x9c,0x8f,0x1e,0xb3,0x91,0xc7,0x73,
+   0x8b,0xb8,0xec,0x8e,0xba,0xf3,0x81,0x28,0x50,0xc1,0xe8,0xa3,0x55,0xb3,0x27,0x16,
+   0x95,0x4a,0xf2,0xae,0xd5,0x25,0xae,0x2b,0x6b,0x72,0x88,0x35,0x4d,0x60
+   };
+
+static const unsigned char fixture_4_4_16[108]=
+   {
+   0xc0,0x03,0xd9,0x2a,0xf3,0xd2,0x69,0x25,0xb3,0x3b,0x5e,0x72,0x3b,0x25,0x71,0xe7,
+   0x25,0x56,0xb7,0x72,0x92,0x3d,0x06,0xd1,0x1e,0x89,0xf7,0xe2,0x7e,0x07,0xa2,0x82,
+   0x17,0xc1,0x80,0x37,0xb4,0x2a,0xbb,0x55,0x95,0x65,0xa3,0x79,0xc8,0xec,0xb2,0x3a,
+   0xa5,0xab,0x01,0xa1,0x8e,0x35,0x6b,0x5f,0x36,0x0e,0xbb,0xf4,0x23,0x4d,0x2f,0x65,
+   0xba,0x4d,0x76,0xa4,0xb2,0xb7,0x63,0xb5,0xb9,0x80,0xd0,0xc4,0xa9,0x29,0xd2,0xba,
+   0x13,0x82,0xfc,0x41,0x40,0x0c,0xb0,0xbd,0xec,0x0f,0xc1,0x14,0x0f,0xc1,0x0b,0xc1,
+   0x7f,0xd8,0x3c,0x03,0xfc,0x01,0x33,0xbb,0x6e,0xd6,0xd9,0xc8
+   };
+
+static const DDS_fixture fixtures[]=
+   {
+   {0,1,1,200,7,3086520058u,fixture_0_1_1},
+   {0,1,3,200,7,1246111482u,fixture_0_1_3},
+   {0,1,16,200,7,1816108307u,fixture_0_1_16},
+   {0,2,1,200,7,3347528442u,fixture_0_2_1},
+   {0,2,3,200,7,2108748538u,fixture_0_2_3},
+   {0,2,16,200,7,2979611731u,fixture_0_2_16},
+   {0,3,1,200,7,3608545018u,fixture_0_3_1},
+   {0,3,3,200,7,2971393786u,fixture_0_3_3},
+   {0,3,16,200,7,4143123347u,fixture_0_3_16},
+   {0,4,1,200,7,3869569786u,fixture_0_4_1},
+   {0,4,3,200,7,3834047226u,fixture_0_4_3},
+   {0,4,16,200,7,1011675859u,fixture_0_4_16},
+   {1,1,1,200,81,4278874892u,fixture_1_1_1},
+   {1,1,3,200,8,1609371611u,fixture_1_1_3},
+   {1,1,16,200,13,513656408u,fixture_1_1_16},
+   {1,2,1,200,107,2877402779u,fixture_1_2_1},
+   {1,2,3,200,14,3842007231u,fixture_1_2_3},
+   {1,2,16,200,21,3783897100u,fixture_1_2_16},
+   {1,3,1,200,135,4040312980u,fixture_1_3_1},
+   {1,3,3,200,22,28264904u,fixture_1_3_3},
+   {1,3,16,200,30,310584094u,fixture_1_3_16},
+   {1,4,1,200,138,1132251594u,fixture_1_4_1},
+   {1,4,3,200,29,3696832459u,fixture_1_4_3},
+   {1,4,16,200,37,1935833614u,fixture_1_4_16},
+   {2,1,1,200,93,3802564831u,fixture_2_1_1},
+   {2,1,3,200,104,3085043597u,fixture_2_1_3},
+   {2,1,16,200,101,2541822830u,fixture_2_1_16},
+   {2,2,1,200,99,2052422550u,fixture_2_2_1},
+   {2,2,3,200,106,3049072987u,fixture_2_2_3},
+   {2,2,16,200,112,2728956583u,fixture_2_2_16},
+   {2,3,1,200,114,286862700u,fixture_2_3_1},
+   {2,3,3,200,111,3173380165u,fixture_2_3_3},
+   {2,3,16,200,110,3264220965u,fixture_2_3_16},
+   {2,4,1,200,108,980479048u,fixture_2_4_1},
+   {2,4,3,200,118,3022212327u,fixture_2_4_3},
+   {2,4,16,200,116,1802459196u,fixture_2_4_16},
+   {3,1,1,200,205,3934614647u,fixture_3_1_1},
+   {3,1,3,200,205,246387955u,fixture_3_1_3},
+   {3,1,16,200,205,3940048682u,fixture_3_1_16},
+   {3,2,1,200,205,3612549046u,fixture_3_2_1},
+   {3,2,3,200,205,3973350076u,fixture_3_2_3},
+   {3,2,16,200,205,3482725620u,fixture_3_2_16},
+   {3,3,1,200,205,2444044262u,fixture_3_3_1},
+   {3,3,3,200,205,2162286371u,fixture_3_3_3},
+   {3,3,16,200,205,2715076877u,fixture_3_3_16},
+   {3,4,1,200,205,2304279218u,fixture_3_4_1},
+   {3,4,3,200,205,3491310259u,fixture_3_4_3},
+   {3,4,16,200,205,529981622u,fixture_3_4_16},
+   {4,1,1,200,82,824055343u,fixture_4_1_1},
+   {4,1,3,200,103,1062129918u,fixture_4_1_3},
+   {4,1,16,200,94,4191247612u,fixture_4_1_16},
+   {4,2,1,200,89,122340999u,fixture_4_2_1},
+   {4,2,3,200,89,3025521520u,fixture_4_2_3},
+   {4,2,16,200,117,1834166111u,fixture_4_2_16},
+   {4,3,1,200,99,3447929777u,fixture_4_3_1},
+   {4,3,3,200,108,2557220163u,fixture_4_3_3},
+   {4,3,16,200,104,1324433105u,fixture_4_3_16},
+   {4,4,1,200,99,383080840u,fixture_4_4_1},
+   {4,4,3,200,94,1331715337u,fixture_4_4_3},
+   {4,4,16,200,108,3013161832u,fixture_4_4_16},
+   {0,1,1,100003,990,4004511027u,NULL},
+   {0,1,3,100003,990,183285427u,NULL},
+   {0,1,16,100003,990,267819091u,NULL},
+   {0,2,1,100003,990,2945147379u,NULL},
+   {0,2,3,100003,990,4020517747u,NULL},
+   {0,2,16,100003,990,110950483u,NULL},
+   {0,3,1,100003,990,1885791923u,NULL},
+   {0,3,3,100003,990,3562790963u,NULL},
+   {0,3,16,100003,990,4249057363u,NULL},
+   {0,4,1,100003,990,826444659u,NULL},
+   {0,4,3,100003,990,3105072371u,NULL},
+   {0,4,16,100003,990,4092205139u,NULL},
+   {1,1,1,100003,38490,1327314273u,NULL},
+   {1,1,3,100003,990,108388510u,NULL},
+   {1,1,16,100003,995,172107535u,NULL},
+   {1,2,1,100003,50991,1328675440u,NULL},
+   {1,2,3,100003,996,30963934u,NULL},
+   {1,2,16,100003,1003,3962148965u,NULL},
+   {1,3,1,100003,63494,1937653085u,NULL},
+   {1,3,3,100003,1003,234714929u,NULL},
+   {1,3,16,100003,1011,1516669416u,NULL},
+   {1,4,1,100003,63495,1019085405u,NULL},
+   {1,4,3,100003,1007,21530709u,NULL},
+   {1,4,16,100003,1015,199366334u,NULL},
+   {2,1,1,100003,43774,628972738u,NULL},
+   {2,1,3,100003,50302,1750470984u,NULL},
+   {2,1,16,100003,50408,1018406002u,NULL},
+   {2,2,1,100003,46950,3519943555u,NULL},
+   {2,2,3,100003,50346,4106528763u,NULL},
+   {2,2,16,100003,50576,369180548u,NULL},
+   {2,3,1,100003,48765,2829578227u,NULL},
+   {2,3,3,100003,50319,3827045018u,NULL},
+   {2,3,16,100003,50657,194097976u,NULL},
+   {2,4,1,100003,49733,4167397957u,NULL},
+   {2,4,3,100003,50340,3984410105u,NULL},
+   {2,4,16,100003,50364,1015542001u,NULL},
+   {3,1,1,100003,101011,690648033u,NULL},
+   {3,1,3,100003,101009,880792016u,NULL},
+   {3,1,16,100003,101020,1080611538u,NULL},
+   {3,2,1,100003,101021,2103184858u,NULL},
+   {3,2,3,100003,101019,815571833u,NULL},
+   {3,2,16,100003,101016,3263665085u,NULL},
+   {3,3,1,100003,101021,1962793650u,NULL},
+   {3,3,3,100003,101015,4190776435u,NULL},
+   {3,3,16,100003,101016,437047434u,NULL},
+   {3,4,1,100003,101018,3217224928u,NULL},
+   {3,4,3,100003,101021,3165877633u,NULL},
+   {3,4,16,100003,101031,1982522933u,NULL},
+   {4,1,1,100003,41018,327876400u,NULL},
+   {4,1,3,100003,46357,3856955201u,NULL},
+   {4,1,16,100003,49103,3651100088u,NULL},
+   {4,2,1,100003,43575,301524100u,NULL},
+   {4,2,3,100003,46149,3762256297u,NULL},
+   {4,2,16,100003,49888,2038545092u,NULL},
+   {4,3,1,100003,44418,3434486028u,NULL},
+   {4,3,3,100003,46582,3407867421u,NULL},
+   {4,3,16,100003,49209,3808226729u,NULL},
+   {4,4,1,100003,44523,4168371945u,NULL},
+   {4,4,3,100003,46054,3705663004u,NULL},
+   {4,4,16,100003,49179,1359462737u,NULL}
+   };
+
+// legacy v3d file of 1000 bytes of kind 2 with seed 7, skip 2 and strip 3
+static const unsigned char legacy_v3d_dds[516]=
+   {
+   0x44,0x44,0x53,0x20,0x76,0x33,0x64,0x0a,0x40,0x00,0x83,0xa9,0x3c,0x6a,0x84,0x1f,
+   0xdd,0x2e,0x25,0x33,0xe2,0x70,0xea,0xdb,0x3c,0x53,0x53,0x4b,0xd4,0x3b,0x63,0x62,
+   0xbb,0x3f,0x2c,0xb5,0x3c,0xbc,0xad,0x53,0x4b,0xca,0xc6,0x4a,0xb5,0x54,0xa5,0x3c,
+   0x43,0x5a,0x73,0x59,0x53,0xc5,0x2d,0xbc,0x53,0x53,0x2d,0x3d,0xc4,0xca,0x53,0xd3,
+   0xa4,0xd4,0x61,0x53,0x5c,0xac,0xd3,0xbb,0x55,0x34,0x3d,0xb3,0x4e,0x3b,0x43,0xc4,
+   0x84,0x0f,0x96,0x1a,0x77,0x06,0x9a,0x1c,0x3c,0xd0,0xe1,0xb6,0x2b,0x72,0x6d,0xd3,
+   0x36,0xa3,0xd9,0xd1,0xd7,0x4e,0xae,0xea,0x7b,0xac,0x1d,0x9e,0x95,0xad,0xc9,0x27,
+   0x11,0x0d,0x8b,0x0f,0x54,0xab,0x8f,0x65,0x34,0x28,0xfb,0x8e,0xe3,0x97,0x91,0x2a,
+   0xb1,0x57,0x30,0x71,0x35,0x47,0x6b,0xad,0x29,0x2d,0xcf,0x45,0x15,0x14,0x79,0x12,
+   0xb1,0x54,0xd0,0xaf,0x55,0x29,0x72,0xeb,0x53,0x2d,0x41,0x8a,0x66,0xb2,0x79,0x2e,
+   0xe9,0x17,0x54,0x38,0xd3,0x31,0x49,0x0f,0x11,0x55,0x48,0xf1,0x6d,0x13,0x2d,0x0d,
+   0x15,0x34,0xb1,0x0d,0x51,0x14,0xd8,0x88,0xd5,0x75,0x3b,0xe4,0x34,0xf5,0xa6,0x72,
+   0x3a,0xaa,0xf9,0x1b,0xb0,0xc0,0xa3,0xd5,0xa7,0x7b,0x4a,0x8b,0x67,0x87,0x78,0xc8,
+   0x68,0x58,0xe5,0xe5,0xe5,0x31,0xe5,0xa2,0x63,0x16,0x16,0xa2,0x62,0x1a,0x5a,0x6e,
+   0x21,0x29,0xed,0xac,0xe1,0xee,0xa2,0x16,0x18,0xb9,0x99,0x77,0x94,0xc5,0xd4,0x87,
+   0x9d,0x76,0x4a,0xb6,0x95,0xc5,0xb7,0x86,0x87,0xaa,0x6b,0x3c,0x67,0x88,0x9a,0x5d,
+   0x38,0x8a,0x17,0xbd,0x3d,0x80,0x21,0xfc,0x37,0xd0,0x9e,0xbf,0x86,0x31,0x3a,0x76,
+   0x74,0x4b,0xb7,0xe6,0x75,0x34,0xec,0xf2,0xb6,0xda,0xb0,0xf1,0x4f,0x6a,0xef,0xad,
+   0x47,0x2d,0xb1,0x29,0x13,0x14,0x93,0x54,0xed,0x0f,0x13,0x30,0xd1,0x4d,0x4d,0x89,
+   0x31,0x50,0x73,0x35,0x2d,0x11,0x2f,0x0b,0xaf,0x10,0xf4,0x75,0x17,0x0d,0x4e,0xf1,
+   0x14,0xb3,0x31,0x0b,0x0f,0x94,0xeb,0x11,0x2d,0x8d,0x49,0x4f,0x4f,0x4f,0x4c,0xb3,
+   0x13,0x4d,0x85,0x0d,0xd2,0xe4,0x43,0x53,0xc3,0x4d,0x4c,0x42,0xd3,0x5b,0x34,0xc5,
+   0x3d,0x42,0xd3,0x52,0x6c,0x3b,0xbd,0xac,0xad,0xbe,0xac,0x34,0x4c,0xcc,0x1d,0xad,
+   0xbd,0x44,0xac,0xb6,0x3c,0x38,0x51,0xfd,0xcb,0xbb,0xe4,0xca,0x42,0xcc,0x5c,0x44,
+   0xbc,0x9d,0x4e,0x3a,0xb3,0xcd,0xc4,0xbc,0x3a,0xdb,0xeb,0x3a,0x54,0x62,0x4b,0x55,
+   0xa4,0xbd,0xca,0x52,0xeb,0x34,0xc4,0xba,0xf2,0xe1,0xca,0xdb,0xda,0x4c,0xd3,0x3d,
+   0x3c,0xb5,0x44,0xb4,0x44,0xb5,0x4b,0x35,0x53,0xa6,0x2d,0xa6,0xbb,0xd4,0x34,0x45,
+   0x2c,0x5b,0x4a,0xd4,0xb5,0x2d,0x3c,0xc8,0xc5,0x2b,0x76,0xb1,0xdd,0x29,0x9e,0xbc,
+   0x9d,0x55,0x3b,0x2e,0x45,0xaa,0x53,0x63,0xcc,0x3d,0xb4,0x26,0x34,0xc5,0x43,0xbb,
+   0x44,0xea,0x74,0x93,0xae,0x2f,0x39,0x92,0x73,0x5d,0xa5,0x5f,0x9a,0xad,0xaf,0x9c,
+   0x3a,0x32,0xef,0x16,0x99,0xad,0x6d,0x72,0x25,0x5d,0xe2,0x66,0xdd,0x97,0x03,0x1f,
+   0x05,0x44,0xf1,0xe2,0x69,0xa1,0x31,0xed,0x1e,0xa9,0xa5,0x65,0xaf,0x15,0xda,0xe2,
+   0x1e,0xce,0x9f,0x00
+   };
+
+// legacy v3d volume of 9x7x5 voxels with 2 components of kind 4 with seed 11
+// * voxel spacing 1x2x0.5 and description "legacy volume"
+static const unsigned char legacy_v3d_pvm[335]=
+   {
+   0x44,0x44,0x53,0x20,0x76,0x33,0x64,0x0a,0x40,0x02,0x0b,0x7d,0x07,0xd3,0xd9,0x68,
+   0x06,0xa9,0x68,0x08,0xe5,0xc8,0x3b,0x96,0xa8,0x09,0x76,0xa8,0x17,0x2a,0x57,0xf8,
+   0xb8,0x04,0x0a,0xa9,0x23,0xed,0xbd,0x25,0x86,0x77,0x24,0x72,0xc5,0x9c,0x90,0x37,
+   0x01,0x00,0x81,0x80,0x7f,0x80,0x06,0x75,0x05,0xc0,0x00,0x07,0x97,0xdb,0xa7,0x6d,
+   0x7f,0xad,0x23,0xce,0x3c,0x9e,0xa6,0xda,0x7b,0x72,0xc7,0x32,0x95,0xd7,0x2a,0xb9,
+   0x57,0x5c,0xca,0xd7,0x24,0x76,0x39,0x63,0xb1,0x67,0x1e,0x92,0x57,0x2c,0x32,0xc7,
+   0xa3,0x7d,0xcb,0x0d,0xb5,0x58,0xa6,0x6e,0xd8,0xf4,0x59,0xc7,0x62,0xb5,0x67,0x5d,
+   0xae,0x3c,0x55,0x4b,0x1b,0xce,0x66,0xac,0xae,0xc5,0xa4,0x95,0xc5,0xdb,0xb1,0x4d,
+   0x55,0xa6,0x76,0xb3,0x73,0xb7,0xa1,0xb6,0x2c,0x7c,0xaf,0xee,0xbd,0x53,0x73,0x59,
+   0xef,0xc8,0x49,0x6a,0x74,0x56,0x57,0x6b,0x5d,0xba,0x0b,0xf1,0x0e,0x87,0x52,0x65,
+   0x33,0x31,0xc7,0x7b,0x5f,0x26,0x1f,0x1d,0xa0,0x44,0xa0,0x35,0xd4,0x62,0x99,0xa0,
+   0x61,0xa0,0x3a,0xe1,0x49,0xdc,0x9e,0xa0,0x60,0xe1,0x42,0x27,0x4e,0x07,0xb9,0x40,
+   0x85,0xf1,0x35,0x71,0xce,0xad,0x5a,0xea,0xbc,0x65,0xab,0x48,0xf3,0x76,0xa9,0x2a,
+   0xd5,0x3e,0xe4,0x8e,0x68,0x74,0x73,0x35,0x71,0x97,0x1b,0x94,0xb2,0x4a,0xa6,0x56,
+   0x46,0xfa,0x99,0x55,0xaa,0xb1,0x67,0x8e,0x91,0xd9,0x25,0x52,0xc7,0x2b,0x76,0xad,
+   0x20,0x3a,0x6e,0x50,0x86,0x52,0x53,0xa0,0x9b,0x89,0xd0,0xc0,0xf4,0x11,0x3f,0x00,
+   0xb3,0xe5,0xd5,0x2a,0x45,0xa4,0xaa,0x3f,0x1c,0x8b,0x56,0xb4,0x56,0xb7,0xda,0xb9,
+   0x4b,0x15,0xa1,0x38,0xc7,0x3c,0x13,0xf8,0x53,0x5c,0x82,0xfc,0xe3,0x05,0xcd,0x5b,
+   0x5b,0xd4,0xd7,0x9a,0xf2,0x56,0x6a,0xcb,0x2c,0x3a,0xb7,0x2b,0xb5,0x3d,0x1c,0xaa,
+   0xe8,0x7c,0x6b,0x47,0x69,0xb2,0xba,0xdc,0xee,0x48,0xe5,0x8e,0x4b,0x1e,0x55,0xca,
+   0xe5,0x0e,0x6a,0xb3,0x13,0xe4,0x9e,0x9e,0xcf,0xb3,0xa1,0x9b,0xc7,0x1f,0xc0
+   };
+
+// legacy v3e file of 2^25+4099 bytes of kind 2 with seed 13, skip 2 and strip 3
+// * the stream spans two interleaving blocks
+#define LEGACY_V3E_BYTES ((1<<25)+4099)
+#define LEGACY_V3E_SIZE (16881973)
+#define LEGACY_V3E_SUM (2214813711u)
+
+#endif
@@ -0,0 +1,178 @@
+// (c) by Stefan Roettger, licensed under MIT license
+
+// stress test of the reentrancy of the DDS codec
+// * N volumes are written and read serially first
+// * then the same volumes are written and decoded at once on N threads,
+//   the decoded bytes must match the serial decode and the written files the serial files
+// * the volumes are of different size and codec,
+//   so single-stream and chunked files are coded at the same time
+
+#include "ddsbase.h"
+
+#include <thread>
+#include <vector>
+
+#define VOLUMES (8)
+#define ROUNDS (3)
+
+struct TestVolume
+   {
+   unsigned int width,height,depth,components;
+   unsigned int codec;
+
+   unsigned char *voxels; // source volume
+   unsigned char *serial; // serially decoded volume
+
+   char name[64],name2[64]; // serially and concurrently written file
+
+   BOOLINT ok;
+   };
+
+// fill a volume with a smooth pattern plus noise
+void fill(TestVolume *v,unsigned int seed)
+   {
+   unsigned long long i,n;
+   unsigned int x,y,z,r;
+
+   n=(unsigned long long)v->width*v->height*v->depth*v->components;
+
+   if ((v->voxels=(unsigned char *)malloc(n))==NULL) ERRORMSG();
+
+   for (r=seed,i=0; i<n; i++)
+      {
+      x=i/v->components%v->width;
+      y=i/v->components/v->width%v->height;
+      z=i/v->components/v->width/v->height;
+
+      r=r*1103515245+12345;
+
+      v->voxels[i]=(x*seed+y*3+z*5)/7+((r>>16)&7);
+      }
+   }
+
+// decode a volume and compare it with an expected volume
+BOOLINT check(const char *filename,const TestVolume *v,const unsigned char *expected)
+   {
+   unsigned char *volume;
+   unsigned int width,height,depth,components;
+
+   BOOLINT ok;
+
+   if ((volume=readPVMvolume(filename,&width,&height,&depth,&components))==NULL) return(FALSE);
+
+   ok=(width==v->width && height==v->height && depth==v->depth && components==v->components &&
+       memcmp(volume,expected,(size_t)width*height*depth*components)==0);
+
+   free(volume);
+
+   return(ok);
+   }
+
+// compare two files byte by byte
+BOOLINT same(const char *filename1,const char *filename2)
+   {
+   unsigned char *data1,*data2;
+   long long bytes1,bytes2;
+
+   BOOLINT ok;
+
+   data1=readRAWfile(filename1,&bytes1);
+   data2=readRAWfile(filename2,&bytes2);
+
+   ok=(data1!=NULL && data2!=NULL && bytes1==bytes2 && memcmp(data1,data2,bytes1)==0);
+
+   free(data1);
+   free(data2);
+
+   return(ok);
+   }
+
+// write a volume
+void writevolume(const TestVolume *v,const char *filename)
+   {
+   writePVMvolume(filename,v->voxels,v->width,v->height,v->depth,v->components,
+                  1.0f,1.0f,1.0f,NULL,NULL,NULL,NULL,v->codec);
+   }
+
+int main(int argc,char *argv[])
+   {
+   unsigned int i,round;
+
+   TestVolume v[VOLUMES];
+
+   unsigned int width,height,depth,components;
+
+   std::vector<std::thread> threads;
+
+   BOOLINT ok=TRUE;
+
+   // volumes below and above the chunk size of 4MB, with one and two components
+   for (i=0; i<VOLUMES; i++)
+      {
+      v[i].width=64+32*i;
+      v[i].height=96;
+      v[i].depth=(i%2==0)?50:400;
+      v[i].components=1+i%3/2;
+      v[i].codec=(i%4==3)?DDS_CODEC_LZ4:DDS_CODEC_DDS;
+
+      fill(&v[i],i+1);
+
+      snprintf(v[i].name,64,"test_dds_threads_%u.pvm",i);
+      snprintf(v[i].name2,64,"test_dds_threads_%u_mt.pvm",i);
+
+      // serial write and decode
+      writevolume(&v[i],v[i].name);
+
+      if ((v[i].serial=readPVMvolume(v[i].name,&width,&height,&depth,&components))==NULL) ERRORMSG();
+
+      if (memcmp(v[i].serial,v[i].voxels,(size_t)v[i].width*v[i].height*v[i].depth*v[i].components)!=0)
+         {
+         fprintf(stderr,"volume %u: serial decode differs from the source\n",i);
+         ok=FALSE;
+         }
+      }
+
+   for (round=0; round<ROUNDS; round++)
+      {
+      // concurrent decode
+      for (i=0; i<VOLUMES; i++)
+         threads.push_back(std::thread([&v,i]() {v[i].ok=check(v[i].name,&v[i],v[i].serial);}));
+
+      for (i=0; i<VOLUMES; i++) threads[i].join();
+      threads.clear();
+
+      for (i=0; i<VOLUMES; i++)
+         if (!v[i].ok)
+            {
+            fprintf(stderr,"round %u, volume %u: concurrent decode differs from the serial decode\n",round,i);
+            ok=FALSE;
+            }
+
+      // concurrent encode
+      for (i=0; i<VOLUMES; i++)
+         threads.push_back(std::thread([&v,i]() {writevolume(&v[i],v[i].name2);}));
+
+      for (i=0; i<VOLUMES; i++) threads[i].join();
+      threads.clear();
+
+      for (i=0; i<VOLUMES; i++)
+         if (!same(v[i].name,v[i].name2))
+            {
+            fprintf(stderr,"round %u, volume %u: concurrent encode differs from the serial encode\n",round,i);
+            ok=FALSE;
+            }
+      }
+
+   for (i=0; i<VOLUMES; i++)
+      {
+      remove(v[i].name);
+      remove(v[i].name2);
+
+      free(v[i].voxels);
+      free(v[i].serial);
+      }
+
+   printf("%s\n",ok?"passed":"FAILED");
+
+   return(ok?0:1);
+   }
@@ -0,0 +1,199 @@
+// (c) by Stefan Roettger, licensed under MIT license
+
+// test of the byte transposition of the DDS codec
+// * the shuffle kernels are checked against a scalar reference
+//   for records of 1 to 4 bytes and odd stream sizes
+// * the DDS coder is checked by a round trip of encode and decode
+// * the codec source is included to reach its internals,
+//   so the test is built with and without SSSE3 to cover both kernels
+
+#include "ddsbase.cpp"
+
+// split a tile into planes holding the first, second, etc. byte of each record
+void reference_transpose(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip)
+   {
+   unsigned int i,j,k;
+
+   for (k=0,i=0; i<skip; i++)
+      for (j=i; j<bytes; j+=skip) dst[k++]=src[j];
+   }
+
+// merge the planes of a tile back into records
+void reference_restore(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip)
+   {
+   unsigned int i,j,k;
+
+   for (k=0,i=0; i<skip; i++)
+      for (j=i; j<bytes; j+=skip) dst[j]=src[k++];
+   }
+
+// deinterleave a stream tile by tile with the reference
+void reference_deinterleave(const unsigned char *src,unsigned char *dst,unsigned int bytes,unsigned int skip,unsigned int block,BOOLINT restore)
+   {
+   unsigned int pos,tile,n;
+
+   tile=(block==0)?bytes:skip*block;
+
+   for (pos=0; pos<bytes; pos+=tile)
+      {
+      n=(bytes-pos<tile)?bytes-pos:tile;
+
+      if (restore) reference_restore(src+pos,dst+pos,n,skip);
+      else reference_transpose(src+pos,dst+pos,n,skip);
+      }
+   }
+
+// fill a stream with random bytes
+void randomize(unsigned char *data,unsigned int bytes,unsigned int seed)
+   {
+   unsigned int i;
+
+   for (i=0; i<bytes; i++)
+      {
+      seed=seed*1103515245+12345;
+      data[i]=seed>>16;
+      }
+   }
+
+// fill a stream with a smooth signal plus noise
+void smooth(unsigned char *data,unsigned int bytes,unsigned int seed)
+   {
+   unsigned int i;
+
+   for (i=0; i<bytes; i++)
+      {
+      seed=seed*1103515245+12345;
+      data[i]=i/5+((seed>>16)&3);
+      }
+   }
+
+// check the transposition of a stream against the reference
+BOOLINT check_transpose(unsigned int bytes,unsigned int skip,unsigned int block)
+   {
+   unsigned char *src,*dst,*ref,*back;
+
+   BOOLINT ok;
+
+   if ((src=(unsigned char *)malloc(bytes+1))==NULL) ERRORMSG();
+   if ((dst=(unsigned char *)malloc(bytes+1))==NULL) ERRORMSG();
+   if ((ref=(unsigned char *)malloc(bytes+1))==NULL) ERRORMSG();
+   if ((back=(unsigned char *)malloc(bytes+1))==NULL) ERRORMSG();
+
+   randomize(src,bytes,bytes*4+skip);
+
+   // guard bytes behind the stream must not be touched
+   dst[bytes]=back[bytes]=0xa5;
+
+   if (block==0) DDS_transpose(src,dst,bytes,skip,FALSE);
+   else DDS_deinterleave(src,dst,bytes,skip,block);
+
+   reference_deinterleave(src,ref,bytes,skip,block,FALSE);
+
+   ok=(memcmp(dst,ref,bytes)==0);
+
+   if (block==0) DDS_transpose(dst,back,bytes,skip,TRUE);
+   else DDS_interleave(dst,back,bytes,skip,block);
+
+   ok=ok && memcmp(back,src,bytes)==0;
+   ok=ok && dst[bytes]==0xa5 && back[bytes]==0xa5;
+
+   if (!ok) fprintf(stderr,"transpose of %u bytes with skip %u and block %u failed\n",bytes,skip,block);
+
+   free(src);
+   free(dst);
+   free(ref);
+   free(back);
+
+   return(ok);
+   }
+
+// check the round trip of a stream through the DDS coder
+BOOLINT check_coder(unsigned int bytes,unsigned int skip,unsigned int strip,unsigned int block)
+   {
+   unsigned char *data,*copy,*chunk,*out;
+   unsigned int size,cnt;
+
+   BOOLINT ok;
+
+   if ((data=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+   if ((copy=(unsigned char *)malloc(bytes))==NULL) ERRORMSG();
+
+   smooth(data,bytes,bytes+strip);
+   memcpy(copy,data,bytes);
+
+   chunk=NULL;
+   size=0;
+
+   DDS_encode(data,bytes,skip,strip,&chunk,&size,block);
+
+   ok=(memcmp(data,copy,bytes)==0);
+
+   out=NULL;
+   cnt=0;
+
+   DDS_decode(chunk,size,&out,&cnt,block);
+
+   ok=ok && cnt==bytes && memcmp(out,copy,bytes)==0;
+
+   if (!ok) fprintf(stderr,"round trip of %u bytes with skip %u, strip %u and block %u failed\n",bytes,skip,strip,block);
+
+   free(data);
+   free(copy);
+   free(chunk);
+   free(out);
+
+   return(ok);
+   }
+
+int main(int argc,char *argv[])
+   {
+   static const unsigned int large[]={4097,65537,1000003};
+   static const unsigned int blocks[]={1,7,64};
+   static const unsigned int strips[]={1,3,17,256};
+
+   unsigned int bytes,skip,i,j;
+
+   BOOLINT ok=TRUE;
+
+#ifdef __SSSE3__
+   printf("SSSE3 kernels\n");
+#else
+   printf("scalar kernels\n");
+#endif
+
+   for (skip=1; skip<=4; skip++)
+      {
+      for (bytes=0; bytes<=300; bytes++)
+         {
+         if (!check_transpose(bytes,skip,0)) ok=FALSE;
+
+         for (i=0; i<sizeof(blocks)/sizeof(blocks[0]); i++)
+            if (!check_transpose(bytes,skip,blocks[i])) ok=FALSE;
+         }
+
+      for (i=0; i<sizeof(large)/sizeof(large[0]); i++)
+         {
+         if (!check_transpose(large[i],skip,0)) ok=FALSE;
+
+         for (j=0; j<sizeof(blocks)/sizeof(blocks[0]); j++)
+            if (!check_transpose(large[i],skip,blocks[j])) ok=FALSE;
+         }
+      }
+
+   for (skip=1; skip<=4; skip++)
+      for (i=0; i<sizeof(strips)/sizeof(strips[0]); i++)
+         {
+         for (bytes=1; bytes<=64; bytes++)
+            if (!check_coder(bytes,skip,strips[i],0)) ok=FALSE;
+
+         for (j=0; j<sizeof(large)/sizeof(large[0]); j++)
+            {
+            if (!check_coder(large[j],skip,strips[i],0)) ok=FALSE;
+            if (!check_coder(large[j],skip,strips[i],64)) ok=FALSE;
+            }
+         }
+
+   printf("%s\n",ok?"passed":"FAILED");
+
+   return(ok?0:1);
+   }
@@ -0,0 +1,257 @@
+// (c) by Stefan Roettger, licensed under MIT license
+
+// test of the non-linear quantization of 16 bit volumes
+// * quantize() and its twin lglQuantizeRaw() are compared with the former per-voxel mapping
+// * the comparison is run with several numbers of threads,
+//   the gradient histogram and the output must be identical regardless of the number of threads
+// * the volumes include rows of several batches of the gradient histogram
+// * the codec source is included to reach the gradient histogram
+
+#include "ddsbase.cpp"
+
+#include "../glvertex/glvertex_rawformat.h"
+
+// helper to get a short value from a volume
+inline int getshort(const unsigned short int *data,
+                    long long width,long long height,long long depth,
+                    long long i,long long j,long long k)
+   {return(data[i+(j+k*height)*width]);}
+
+// helper to get a gradient value from a volume
+inline double getgrad(const unsigned short int *data,
+                      long long width,long long height,long long depth,
+                      long long i,long long j,long long k)
+   {
+   double gx,gy,gz;
+
+   if (i>0)
+      if (i<width-1) gx=(getshort(data,width,height,depth,i+1,j,k)-getshort(data,width,height,depth,i-1,j,k))/2.0;
+      else gx=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i-1,j,k);
+   else
+      if (i<width-1) gx=getshort(data,width,height,depth,i+1,j,k)-getshort(data,width,height,depth,i,j,k);
+      else gx=0.0;
+
+   if (j>0)
+      if (j<height-1) gy=(getshort(data,width,height,depth,i,j+1,k)-getshort(data,width,height,depth,i,j-1,k))/2.0;
+      else gy=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i,j-1,k);
+   else
+      if (j<height-1) gy=getshort(data,width,height,depth,i,j+1,k)-getshort(data,width,height,depth,i,j,k);
+      else gy=0.0;
+
+   if (k>0)
+      if (k<depth-1) gz=(getshort(data,width,height,depth,i,j,k+1)-getshort(data,width,height,depth,i,j,k-1))/2.0;
+      else gz=getshort(data,width,height,depth,i,j,k)-getshort(data,width,height,depth,i,j,k-1);
+   else
+      if (k<depth-1) gz=getshort(data,width,height,depth,i,j,k+1)-getshort(data,width,height,depth,i,j,k);
+      else gz=0.0;
+
+   return(sqrt(gx*gx+gy*gy+gz*gz));
+   }
+
+// former serial gradient histogram with per-voxel gradients
+void reference_hist(const unsigned short int *data,
+                    long long width,long long height,long long depth,
+                    double *err)
+   {
+   long long i,j,k;
+
+   for (i=0; i<65536; i++) err[i]=0.0;
+
+   for (k=0; k<depth; k++)
+      for (j=0; j<height; j++)
+         for (i=0; i<width; i++)
+            err[getshort(data,width,height,depth,i,j,k)]+=sqrt(getgrad(data,width,height,depth,i,j,k));
+   }
+
+// former serial mapping with per-voxel gradients
+unsigned char *reference(const unsigned short int *data,
+                         long long width,long long height,long long depth)
+   {
+   long long i,k;
+
+   unsigned char *data2;
+   long long idx;
+
+   int v,vmin,vmax;
+
+   double *err,eint;
+
+   BOOLINT linear,done;
+
+   vmin=65535;
+   vmax=0;
+
+   for (idx=0; idx<width*height*depth; idx++)
+      {
+      v=data[idx];
+      if (v<vmin) vmin=v;
+      if (v>vmax) vmax=v;
+      }
+
+   if (vmin==vmax) vmax=vmin+1;
+
+   linear=(vmax-vmin<256);
+
+   err=new double[65536];
+
+   if (linear)
+      for (i=0; i<65536; i++) err[i]=255*(double)(i-vmin)/(vmax-vmin);
+   else
+      {
+      reference_hist(data,width,height,depth,err);
+
+      for (i=0; i<65536; i++) err[i]=pow(err[i],1.0/3);
+
+      err[vmin]=err[vmax]=0.0;
+
+      for (k=0; k<256; k++)
+         {
+         for (eint=0.0,i=0; i<65536; i++) eint+=err[i];
+
+         done=TRUE;
+
+         for (i=0; i<65536; i++)
+            if (err[i]>eint/256)
+               {
+               err[i]=eint/256;
+               done=FALSE;
+               }
+
+         if (done) break;
+         }
+
+      for (i=1; i<65536; i++) err[i]+=err[i-1];
+
+      if (err[65535]>0.0f)
+         for (i=0; i<65536; i++) err[i]*=255.0/err[65535];
+      }
+
+   if ((data2=(unsigned char *)malloc(width*height*depth))==NULL) ERRORMSG();
+
+   for (idx=0; idx<width*height*depth; idx++)
+      data2[idx]=(int)(err[data[idx]]+0.5);
+
+   delete[] err;
+
+   return(data2);
+   }
+
+// fill a volume with a smooth pattern plus noise in the given value range
+void fill(unsigned short int *data,
+          long long width,long long height,long long depth,
+          unsigned int range,unsigned int seed)
+   {
+   long long i,j,k;
+   unsigned int r;
+
+   for (r=seed,k=0; k<depth; k++)
+      for (j=0; j<height; j++)
+         for (i=0; i<width; i++)
+            {
+            r=r*1103515245+12345;
+            data[i+(j+k*height)*width]=((i*7+j*13+k*29)*range/(width*7+height*13+depth*29)+(r>>16)%97)%range;
+            }
+   }
+
+// compare both quantizations with the reference on a number of threads
+BOOLINT check(long long width,long long height,long long depth,unsigned int range,unsigned int threads)
+   {
+   long long idx,cells;
+
+   unsigned short int *data;
+   unsigned char *bytes,*ref,*out1,*out2,*out3;
+
+   double *hist,*hist1,*hist2;
+
+   BOOLINT ok;
+
+   cells=width*height*depth;
+
+   if ((data=(unsigned short int *)malloc(cells*sizeof(unsigned short int)))==NULL) ERRORMSG();
+   if ((bytes=(unsigned char *)malloc(2*cells))==NULL) ERRORMSG();
+
+   fill(data,width,height,depth,range,width+height+depth+range);
+
+   ref=reference(data,width,height,depth);
+
+   // msb and lsb byte order of quantize()
+   for (idx=0; idx<cells; idx++)
+      {
+      bytes[2*idx]=data[idx]>>8;
+      bytes[2*idx+1]=data[idx]&255;
+      }
+
+   out1=quantize(bytes,width,height,depth,TRUE,FALSE,TRUE,threads);
+
+   for (idx=0; idx<cells; idx++)
+      {
+      bytes[2*idx]=data[idx]&255;
+      bytes[2*idx+1]=data[idx]>>8;
+      }
+
+   out2=quantize(bytes,width,height,depth,FALSE,FALSE,TRUE,threads);
+
+   out3=lglQuantizeRaw(data,width,height,depth,false,threads);
+
+   ok=TRUE;
+
+   // the histograms must be identical bit by bit
+   hist=new double[65536];
+   hist1=new double[65536];
+   hist2=new double[65536];
+
+   reference_hist(data,width,height,depth,hist);
+   DDS_gradhist(data,width,height,depth,hist1,threads);
+   lglAccumulateRawGradHist(data,width,height,depth,hist2,threads);
+
+   if (memcmp(hist1,hist,65536*sizeof(double))!=0 || memcmp(hist2,hist,65536*sizeof(double))!=0)
+      {
+      fprintf(stderr,"gradient histogram of %lldx%lldx%lld (range %u) on %u threads differs from the reference\n",width,height,depth,range,threads);
+      ok=FALSE;
+      }
+
+   delete[] hist;
+   delete[] hist1;
+   delete[] hist2;
+
+   if (memcmp(out1,ref,cells)!=0 || memcmp(out2,ref,cells)!=0)
+      {
+      fprintf(stderr,"quantize of %lldx%lldx%lld (range %u) on %u threads differs from the reference\n",width,height,depth,range,threads);
+      ok=FALSE;
+      }
+
+   if (out3==NULL || memcmp(out3,ref,cells)!=0)
+      {
+      fprintf(stderr,"lglQuantizeRaw of %lldx%lldx%lld (range %u) on %u threads differs from the reference\n",width,height,depth,range,threads);
+      ok=FALSE;
+      }
+
+   free(data);
+   free(bytes);
+   free(ref);
+   free(out1);
+   free(out2);
+   free(out3);
+
+   return(ok);
+   }
+
+int main(int argc,char *argv[])
+   {
+   static const long long sizes[][3]={{1,1,1},{2,1,1},{1,5,1},{7,1,3},{33,17,2},{64,48,40},{300,7,9},{4096,100,5}};
+   static const unsigned int ranges[]={200,4000,65536};
+   static const unsigned int threads[]={1,2,3,4,8,13};
+
+   unsigned int i,j,t;
+
+   BOOLINT ok=TRUE;
+
+   for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+      for (j=0; j<sizeof(ranges)/sizeof(ranges[0]); j++)
+         for (t=0; t<sizeof(threads)/sizeof(threads[0]); t++)
+            if (!check(sizes[i][0],sizes[i][1],sizes[i][2],ranges[j],threads[t])) ok=FALSE;
+
+   printf("%s\n",ok?"passed":"FAILED");
+
+   return(ok?0:1);
+   }